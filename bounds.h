@@ -0,0 +1,161 @@
+#ifndef _BOUNDS_H_
+#define _BOUNDS_H_
+
+#include <set>
+#include <vector>
+
+#include "problem_info.h"
+
+/**
+ * Limites (menor e maior valor) de cada objetivo de um conjunto de
+ * vetores mantidos de forma incremental.
+ *
+ * Cada objetivo possui um multiset ordenado com os valores do conjunto,
+ * assim inserir e remover um vetor custa O(OBJECTIVES * log N) e os
+ * limites são lidos em O(1), sem ordenar a população a cada geração.
+ *
+ * Os algoritmos inserem cada indivíduo avaliado e removem os que são
+ * substituídos. A partir dos limites são obtidos o ponto ideal, o ponto
+ * nadir e a normalização dos objetivos para [0, 1], utilizada pela
+ * crowding distance do Nsga2 e pelas distâncias do Spea2 para que um
+ * objetivo de escala grande não domine os demais.
+ *
+ * Indivíduos com objetivos preditos (ScreenedProblem) e vetores com
+ * algum objetivo NaN contam em size, mas não nos limites.
+ *
+ * @date 18/10/2026
+ */
+class ObjectiveBounds {
+
+public:
+
+	/**
+	 * @param int quantidade de objetivos (padrão: a da thread corrente)
+	 */
+	ObjectiveBounds (int objectives = Info::OBJECTIVES)
+		: m_values (objectives), m_found (objectives), m_size (0), m_excluded (0) {}
+
+	/**
+	 * Insere um vetor. Um vetor com algum objetivo NaN conta em size,
+	 * mas não entra nos limites.
+	 *
+	 * @return bool falso se o vetor não entrou nos limites
+	 */
+	bool insert (const double * obj) {
+		m_size++;
+		if (!valid (obj)) {
+			m_excluded++;
+			return false;
+		}
+		for (unsigned j=0; j < m_values.size (); j++) m_values[j].insert (obj[j]);
+		return true;
+	}
+
+	/**
+	 * Remove um vetor previamente inserido. Se o vetor não está no
+	 * conjunto nada é alterado.
+	 *
+	 * @return bool falso se o vetor não foi encontrado
+	 */
+	bool erase (const double * obj) {
+		if (!valid (obj)) return eraseExcluded ();
+
+		for (unsigned j=0; j < m_values.size (); j++) {
+			m_found[j] = m_values[j].find (obj[j]);
+			if (m_found[j] == m_values[j].end ()) return false;
+		}
+		for (unsigned j=0; j < m_values.size (); j++) m_values[j].erase (m_found[j]);
+		m_size--;
+		return true;
+	}
+
+	/**
+	 * Insere e remove os objetivos de um indivíduo (os de um indivíduo
+	 * predito, assim como um vetor com NaN, não entram nos limites).
+	 */
+	template <class Individual>
+	bool insert (const Individual * individual) {
+		if (!individual->predicted) return insert (individual->obj);
+		m_size++;
+		m_excluded++;
+		return false;
+	}
+
+	template <class Individual>
+	bool erase (const Individual * individual) {
+		return individual->predicted ? eraseExcluded () : erase (individual->obj);
+	}
+
+	void clear () {
+		for (unsigned j=0; j < m_values.size (); j++) m_values[j].clear ();
+		m_size = 0;
+		m_excluded = 0;
+	}
+
+	/**
+	 * Reinicia os limites com os indivíduos population[0, size).
+	 */
+	template <class Individual>
+	void reset (Individual ** population, int size) {
+		clear ();
+		for (int i=0; i < size; i++) insert (population[i]);
+	}
+
+	int size () const { return m_size; }
+
+	double lower (int j) const { return m_values[j].empty () ? 0.0 : *m_values[j].begin (); }
+	double upper (int j) const { return m_values[j].empty () ? 0.0 : *m_values[j].rbegin (); }
+	double range (int j) const { return upper (j) - lower (j); }
+
+	/**
+	 * Melhor e pior valor do objetivo j conforme o sentido de
+	 * otimização (Info::objconf).
+	 */
+	double ideal (int j) const { return Info::objconf[j] < 0 ? upper (j) : lower (j); }
+	double nadir (int j) const { return Info::objconf[j] < 0 ? lower (j) : upper (j); }
+
+	/**
+	 * Fator de escala do objetivo j para o intervalo [0, 1]. Um
+	 * objetivo sem variação tem escala zero.
+	 */
+	double scale (int j) const {
+		double r = range (j);
+		return r > 0.0 ? 1.0 / r : 0.0;
+	}
+
+	/**
+	 * Valor do objetivo j normalizado para [0, 1].
+	 */
+	double normalize (int j, double value) const {
+		return (value - lower (j)) * scale (j);
+	}
+
+	void normalize (const double * obj, double * out) const {
+		for (unsigned j=0; j < m_values.size (); j++) out[j] = normalize (j, obj[j]);
+	}
+
+private:
+
+	bool valid (const double * obj) const {
+		for (unsigned j=0; j < m_values.size (); j++) {
+			if (obj[j] != obj[j]) return false;
+		}
+		return true;
+	}
+
+	bool eraseExcluded () {
+		if (m_excluded == 0) return false;
+		m_excluded--;
+		m_size--;
+		return true;
+	}
+
+	std::vector<std::multiset<double> > m_values;
+	std::vector<std::multiset<double>::iterator> m_found;
+
+	//quantidade de vetores e de vetores fora dos limites (NaN ou preditos)
+	int m_size;
+	int m_excluded;
+};
+
+#endif
@@ -0,0 +1,412 @@
+#ifndef _CHECKPOINT_H_
+#define _CHECKPOINT_H_
+
+#include <stdint.h>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cerrno>
+
+#include <unistd.h>
+
+#include "generic_individual.h"
+#include "random.h"
+#include "mapped_file.h"
+#include "epsilon_archive.h"
+
+/**
+ * Checkpoint e reinício dos algoritmos.
+ *
+ * O estado completo de uma execução (população, fronteira do
+ * arquivo, geração corrente, estado do gerador aleatório, fronts e
+ * arquivo ε) é gravado em um arquivo binário versionado. O arquivo é escrito
+ * na ordem nativa de bytes da máquina e todas as seções são alinhadas
+ * em 8 bytes, de modo que ele pode ser mapeado em memória (mmap) e
+ * lido sem cópias.
+ *
+ * Formato (versão 2):
+ *
+ *		Header
+ *		Record     [size]             informações de cada indivíduo
+ *		double     [size * objectives] objetivos, um indivíduo por linha
+ *		Front      [fronts]           fronts (apenas Nsga2)
+ *		double     [archive * objectives] vetores do arquivo ε
+ *		int64_t    [archive * objectives] caixas dos vetores do arquivo ε
+ *		char       [...]              genótipos serializados pela política
+ *
+ * A seção do arquivo ε começa logo após os fronts (alinhada em 8);
+ * checkpoints sem arquivo ε têm archive = 0 e a seção é vazia.
+ *
+ * A política de problema deve fornecer dois métodos para serializar
+ * o genótipo:
+ *
+ *		void write (const genotype_type &, std::vector<char> &);
+ *		void read (const char *, size_t, genotype_type &);
+ *
+ * @date 18/10/2026
+ */
+namespace Checkpoint {
+
+	enum {MAGIC = 0x54504b43, VERSION = 2};
+	enum {NSGA2 = 1, SPEA2 = 2};
+
+	struct Header {
+		uint32_t magic;
+		uint32_t version;
+		uint32_t algorithm;
+		uint32_t objectives;
+
+		int32_t generation;
+		int32_t popsize;	//POPSIZE corrente (no Spea2 muda após a 1ª geração)
+		int32_t arcsize;	//tamanho do arquivo (0 no Nsga2)
+		int32_t size;		//quantidade de indivíduos gravados
+
+		int32_t fronts;
+		int32_t archive;	//vetores do arquivo ε (0 sem arquivo)
+
+		uint64_t random[4];
+
+		uint64_t records_offset;
+		uint64_t objectives_offset;
+		uint64_t fronts_offset;
+		uint64_t genotypes_offset;
+		uint64_t file_size;
+	};
+
+	//marcas de um indivíduo (Record::flags)
+	enum { PREDICTED = 1 };
+
+	struct Record {
+		int32_t index;
+		int32_t flags;		//PREDICTED
+		double fitness;
+		double crownding;
+		double violation;
+		uint64_t genotype_offset;	//relativo a genotypes_offset
+		uint64_t genotype_size;
+	};
+
+	struct Front {
+		int32_t index;
+		int32_t counter;
+		int32_t begin;
+		int32_t end;
+	};
+
+	inline uint64_t align8 (uint64_t value) {
+		return (value + 7) & ~(uint64_t)7;
+	}
+
+	/**
+	 * Início da seção do arquivo ε, logo após os fronts.
+	 */
+	inline uint64_t archiveOffset (const Header & header) {
+		return align8 (header.fronts_offset + (uint64_t) header.fronts * sizeof (Front));
+	}
+
+	/**
+	 * Monta a imagem binária de um checkpoint em image.
+	 * A imagem é uma cópia do estado; após esta função a execução
+	 * pode seguir alterando a população sem afetar a gravação.
+	 *
+	 * O header deve vir preenchido com algorithm, generation, popsize
+	 * e arcsize. Os demais campos são calculados aqui. archive é o
+	 * arquivo ε da execução (NULL sem arquivo).
+	 */
+	template <class Problem>
+	void build (std::vector<char> & image, Header header,
+			const Random & random, Problem & problem,
+			GenericIndividual<typename Problem::genotype_type> ** population,
+			int size, const std::vector<Front> & fronts,
+			const EpsilonArchive * archive = NULL)
+	{
+		const int M = Info::OBJECTIVES;
+
+		std::vector<char> genotypes;
+		std::vector<Record> records (size);
+		for (int i=0; i < size; i++) {
+			records[i].index = population[i]->index;
+			records[i].flags = population[i]->predicted ? PREDICTED : 0;
+			records[i].fitness = population[i]->fitness;
+			records[i].crownding = population[i]->crownding;
+			records[i].violation = population[i]->violation;
+			records[i].genotype_offset = genotypes.size ();
+			problem.write (population[i]->genotype, genotypes);
+			records[i].genotype_size = genotypes.size () - records[i].genotype_offset;
+		}
+
+		header.magic = MAGIC;
+		header.version = VERSION;
+		header.objectives = M;
+		header.size = size;
+		header.fronts = (int32_t) fronts.size ();
+		header.archive = archive != NULL ? archive->size () : 0;
+		memcpy (header.random, random.state, sizeof (header.random));
+
+		const uint64_t entries = (uint64_t) header.archive * M;
+
+		header.records_offset = align8 (sizeof (Header));
+		header.objectives_offset = align8 (header.records_offset + size * sizeof (Record));
+		header.fronts_offset = align8 (header.objectives_offset + (uint64_t)size * M * sizeof (double));
+		header.genotypes_offset = archiveOffset (header) + entries * (sizeof (double) + sizeof (int64_t));
+		header.file_size = header.genotypes_offset + genotypes.size ();
+
+		image.assign (header.file_size, 0);
+		memcpy (&image[0], &header, sizeof (Header));
+		if (size > 0) {
+			memcpy (&image[header.records_offset], &records[0], size * sizeof (Record));
+		}
+		double * obj = (double *) &image[header.objectives_offset];
+		for (int i=0; i < size; i++) {
+			memcpy (obj + (uint64_t)i * M, population[i]->obj, M * sizeof (double));
+		}
+		if (!fronts.empty ()) {
+			memcpy (&image[header.fronts_offset], &fronts[0], fronts.size () * sizeof (Front));
+		}
+		if (entries > 0) {
+			const uint64_t offset = archiveOffset (header);
+			memcpy (&image[offset], archive->values ().data (), entries * sizeof (double));
+			memcpy (&image[offset + entries * sizeof (double)], archive->boxes ().data (),
+					entries * sizeof (int64_t));
+		}
+		if (!genotypes.empty ()) {
+			memcpy (&image[header.genotypes_offset], &genotypes[0], genotypes.size ());
+		}
+	}
+
+	/**
+	 * Leitor de checkpoints. O arquivo é mapeado em memória e as
+	 * seções são acessadas diretamente, sem cópia.
+	 */
+	class Reader {
+
+	public:
+		Reader (const std::string & file)
+			: m_file (file), m_data (m_file.data ()) {}
+
+		/**
+		 * Retorna verdadeiro se o arquivo foi mapeado, o header é de
+		 * uma versão conhecida e consistente com o problema corrente e
+		 * todas as seções (e o genótipo de cada registro) estão dentro
+		 * do arquivo. Um checkpoint truncado ou corrompido é recusado
+		 * aqui, antes de qualquer acesso às seções.
+		 */
+		bool valid () const {
+			const uint64_t file_size = m_file.size ();
+			if (m_data == NULL || file_size < sizeof (Header)) return false;
+
+			const Header & h = header ();
+			if (h.magic != MAGIC || h.version != VERSION ||
+					h.objectives != (uint32_t) Info::OBJECTIVES ||
+					h.file_size != file_size || h.size < 0 || h.fronts < 0 || h.archive < 0) return false;
+
+			const uint64_t size = (uint64_t) h.size;
+			const uint64_t entries = (uint64_t) h.archive * h.objectives;
+			if (!section (h.records_offset, size * sizeof (Record)) ||
+					!section (h.objectives_offset, size * h.objectives * sizeof (double)) ||
+					!section (h.fronts_offset, (uint64_t) h.fronts * sizeof (Front)) ||
+					!section (archiveOffset (h), entries * (sizeof (double) + sizeof (int64_t))) ||
+					!section (h.genotypes_offset, 0) ||
+					h.genotypes_offset < archiveOffset (h) + entries * (sizeof (double) + sizeof (int64_t))) return false;
+
+			const uint64_t genotypes = file_size - h.genotypes_offset;
+			for (int i=0; i < h.size; i++) {
+				const Record & r = records ()[i];
+				if (r.genotype_offset > genotypes || r.genotype_size > genotypes - r.genotype_offset) return false;
+			}
+			for (int i=0; i < h.fronts; i++) {
+				const Front & f = fronts ()[i];
+				//begin e end são posições da população, ambas inclusivas
+				if (f.begin < 0 || f.begin > f.end || f.end >= h.size) return false;
+			}
+			return true;
+		}
+
+		const Header & header () const {
+			return *(const Header *) m_data;
+		}
+
+		const Record * records () const {
+			return (const Record *) (m_data + header ().records_offset);
+		}
+
+		const double * objectives (int i) const {
+			return (const double *) (m_data + header ().objectives_offset) +
+					(uint64_t) i * header ().objectives;
+		}
+
+		const Front * fronts () const {
+			return (const Front *) (m_data + header ().fronts_offset);
+		}
+
+		const char * genotype (int i) const {
+			return m_data + header ().genotypes_offset + records ()[i].genotype_offset;
+		}
+
+		/**
+		 * Vetores do arquivo ε (header().archive linhas), seguidos das
+		 * suas caixas.
+		 */
+		const double * archiveValues () const {
+			return (const double *) (m_data + archiveOffset (header ()));
+		}
+
+		const int64_t * archiveBoxes () const {
+			return (const int64_t *) (archiveValues () + (uint64_t) header ().archive * header ().objectives);
+		}
+
+		/**
+		 * Restaura o arquivo ε gravado em archive. Um checkpoint sem
+		 * arquivo ε deixa archive vazio.
+		 */
+		void restore (EpsilonArchive & archive) const {
+			archive.restore (archiveValues (), archiveBoxes (), header ().archive);
+		}
+
+		/**
+		 * Restaura os indivíduos gravados em population, que deve
+		 * possuir header().size posições já alocadas.
+		 */
+		template <class Problem>
+		void restore (Problem & problem,
+				GenericIndividual<typename Problem::genotype_type> ** population,
+				Random & random) const
+		{
+			const Header & h = header ();
+			for (int i=0; i < h.size; i++) {
+				const Record & r = records ()[i];
+				population[i]->index = r.index;
+				population[i]->fitness = r.fitness;
+				population[i]->crownding = r.crownding;
+				population[i]->violation = r.violation;
+				population[i]->predicted = (r.flags & PREDICTED) != 0;
+				memcpy (population[i]->obj, objectives (i), h.objectives * sizeof (double));
+				problem.read (genotype (i), r.genotype_size, population[i]->genotype);
+			}
+			memcpy (random.state, h.random, sizeof (random.state));
+		}
+
+	private:
+		/**
+		 * A seção de bytes bytes em offset (alinhado em 8) está dentro
+		 * do arquivo.
+		 */
+		bool section (uint64_t offset, uint64_t bytes) const {
+			const uint64_t file_size = m_file.size ();
+			return offset % 8 == 0 && offset <= file_size && bytes <= file_size - offset;
+		}
+
+		MappedFile m_file;
+		const char * m_data;
+	};
+
+	/**
+	 * Escritor assíncrono de checkpoints.
+	 *
+	 * A imagem é montada pela thread do algoritmo (apenas cópia de
+	 * memória) e gravada em disco por uma thread em segundo plano.
+	 * A gravação é feita em um arquivo temporário renomeado ao final,
+	 * assim um checkpoint interrompido nunca sobrescreve o anterior.
+	 *
+	 * Se um novo checkpoint chega antes da gravação do anterior, o
+	 * pendente é descartado e apenas o mais recente é gravado.
+	 *
+	 * Uma gravação que falha (arquivo que não pode ser criado, disco
+	 * cheio) é descrita em stderr e fica registrada em failed.
+	 */
+	class Writer {
+
+	public:
+		Writer () : m_pending (false), m_stop (false), m_failed (false) {
+			m_thread = std::thread (&Writer::loop, this);
+		}
+
+		/**
+		 * Aguarda a gravação do checkpoint pendente e encerra a thread.
+		 */
+		~Writer () {
+			{
+				std::lock_guard<std::mutex> lock (m_mutex);
+				m_stop = true;
+			}
+			m_cond.notify_one ();
+			m_thread.join ();
+		}
+
+		/**
+		 * Agenda a gravação da imagem no arquivo indicado. O conteúdo
+		 * de image é trocado com o buffer interno (sem cópia).
+		 */
+		void submit (const std::string & file, std::vector<char> & image) {
+			{
+				std::lock_guard<std::mutex> lock (m_mutex);
+				m_file = file;
+				m_image.swap (image);
+				m_pending = true;
+			}
+			m_cond.notify_one ();
+		}
+
+		/**
+		 * Verdadeiro se alguma gravação falhou.
+		 */
+		bool failed () const { return m_failed; }
+
+	private:
+		void loop () {
+
+			std::vector<char> image;
+			std::string file;
+
+			while (true) {
+				{
+					std::unique_lock<std::mutex> lock (m_mutex);
+					while (!m_pending && !m_stop) m_cond.wait (lock);
+					if (!m_pending && m_stop) return;
+					image.swap (m_image);
+					file = m_file;
+					m_pending = false;
+				}
+
+				std::string tmp = file + ".tmp";
+				FILE * out = fopen (tmp.c_str (), "wb");
+				if (out == NULL) {
+					fail (tmp);
+					continue;
+				}
+
+				bool ok = fwrite (&image[0], 1, image.size (), out) == image.size ();
+				ok = (fflush (out) == 0) && ok;
+				ok = (fsync (fileno (out)) == 0) && ok;
+				ok = (fclose (out) == 0) && ok;
+
+				if (ok) ok = rename (tmp.c_str (), file.c_str ()) == 0;
+				else remove (tmp.c_str ());
+				if (!ok) fail (file);
+			}
+		}
+
+		std::thread m_thread;
+		std::mutex m_mutex;
+		std::condition_variable m_cond;
+
+		void fail (const std::string & file) {
+			fprintf (stderr, "Checkpoint: não foi possível gravar %s: %s\n", file.c_str (), strerror (errno));
+			m_failed = true;
+		}
+
+		std::vector<char> m_image;
+		std::string m_file;
+		bool m_pending;
+		bool m_stop;
+		std::atomic<bool> m_failed;
+	};
+
+}
+
+#endif
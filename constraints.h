@@ -0,0 +1,54 @@
+#ifndef _CONSTRAINTS_H_
+#define _CONSTRAINTS_H_
+
+#include <vector>
+#include <algorithm>
+
+/**
+ * Tratamento de restrições pela dominância com restrições de Deb
+ * (Deb et al, 2002):
+ *
+ *  - um indivíduo viável domina qualquer indivíduo inviável;
+ *  - entre dois inviáveis, domina o de menor violação;
+ *  - entre dois viáveis, vale a dominância de Pareto usual.
+ *
+ * Os algoritmos separam a população em duas partições, viáveis e
+ * inviáveis. A dominância de Pareto é avaliada apenas dentro da
+ * partição viável; a relação com e entre os inviáveis depende só da
+ * violação e é resolvida por ordenação. Quando todos os indivíduos
+ * são viáveis (caso comum), os algoritmos seguem o caminho original.
+ *
+ * @see MultiObjective::dominate
+ * @date 18/10/2026
+ */
+namespace Constraints {
+
+	/**
+	 * Separa os índices de population[0, size) em viáveis e inviáveis.
+	 * Os inviáveis são ordenados por violação crescente.
+	 *
+	 * @return quantidade de indivíduos inviáveis
+	 */
+	template <class Individual>
+	int partition (Individual ** population, int size,
+			std::vector<int> & feasible, std::vector<int> & infeasible)
+	{
+		feasible.clear ();
+		infeasible.clear ();
+
+		for (int i=0; i < size; i++) {
+			if (population[i]->violation > 0.0) infeasible.push_back (i);
+			else feasible.push_back (i);
+		}
+
+		std::stable_sort (infeasible.begin (), infeasible.end (),
+			[population] (int a, int b) {
+				return population[a]->violation < population[b]->violation;
+			});
+
+		return (int) infeasible.size ();
+	}
+
+}
+
+#endif
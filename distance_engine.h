@@ -0,0 +1,211 @@
+#ifndef _DISTANCE_ENGINE_H_
+#define _DISTANCE_ENGINE_H_
+
+#include <vector>
+#include <limits>
+#include <algorithm>
+
+#include "problem_info.h"
+#include "bounds.h"
+
+/**
+ * Distâncias euclidianas entre os vetores de objetivos utilizadas pelo
+ * Spea2 (densidade e truncamento do arquivo).
+ *
+ * As comparações são feitas com o quadrado da distância; a raiz só é
+ * calculada quando o valor da distância é necessário (densidade). Os
+ * objetivos são copiados por coluna (um vetor contíguo por objetivo),
+ * assim o laço interno percorre memória contígua e pode ser vetorizado
+ * pelo compilador.
+ *
+ * A matriz de distâncias não é armazenada:
+ *
+ *  - kthNearest calcula uma linha por vez em um buffer de size
+ *    posições e seleciona o k-ésimo menor valor (nth_element);
+ *  - o truncamento mantém, para cada vetor, o vizinho mais próximo
+ *    entre os vetores seguintes ainda presentes. Ao remover um vetor
+ *    apenas os vetores que o tinham como vizinho são recalculados.
+ *
+ * A memória é O(size * OBJECTIVES) em vez de O(size^2). No modo de
+ * precisão simples os objetivos e as distâncias são float (metade da
+ * memória e o dobro de elementos por instrução vetorial), o que pode
+ * mudar a ordem de distâncias muito próximas.
+ *
+ * @date 18/10/2026
+ */
+class DistanceEngine {
+
+public:
+
+	DistanceEngine (bool single = false) : m_single (single), m_size (0) {}
+
+	void setSinglePrecision (bool single) { m_single = single; }
+	bool singlePrecision () const { return m_single; }
+
+	/**
+	 * Copia os objetivos de population[0, size). Com bounds os
+	 * objetivos são normalizados para [0, 1] pelos seus limites.
+	 */
+	template <class Individual>
+	void load (Individual ** population, int size, const ObjectiveBounds * bounds = NULL) {
+		if (m_single) m_float.load (population, size, bounds);
+		else m_double.load (population, size, bounds);
+		m_size = size;
+	}
+
+	/**
+	 * out[i] recebe o quadrado da distância do vetor i ao seu k-ésimo
+	 * vizinho mais próximo, contando o próprio vetor (distância zero)
+	 * como a posição 0.
+	 */
+	void kthNearest (int k, std::vector<double> & out) {
+		if (m_single) m_float.kthNearest (k, out);
+		else m_double.kthNearest (k, out);
+	}
+
+	/**
+	 * Inicia o truncamento sobre todos os vetores carregados.
+	 */
+	void beginTruncation () {
+		if (m_single) m_float.beginTruncation ();
+		else m_double.beginTruncation ();
+	}
+
+	/**
+	 * Retorna o vetor i do par (i, j), i < j, de menor distância entre
+	 * os vetores presentes. Empates são resolvidos pelo primeiro par na
+	 * ordem lexicográfica de (i, j).
+	 */
+	int closest () {
+		return m_single ? m_float.closest () : m_double.closest ();
+	}
+
+	/**
+	 * Remove o vetor i do truncamento.
+	 */
+	void remove (int i) {
+		if (m_single) m_float.remove (i);
+		else m_double.remove (i);
+	}
+
+	/**
+	 * Quantidade de vetores presentes antes do vetor i.
+	 */
+	int position (int i) const {
+		const std::vector<char> & alive = m_single ? m_float.alive : m_double.alive;
+		int count = 0;
+		for (int j=0; j < i; j++) count += alive[j];
+		return count;
+	}
+
+private:
+
+	template <class Real>
+	struct Store {
+
+		template <class Individual>
+		void load (Individual ** population, int size, const ObjectiveBounds * bounds) {
+			const int M = Info::OBJECTIVES;
+			n = size;
+			columns.resize ((size_t) M * size);
+			for (int m=0; m < M; m++) {
+				Real * column = columns.data () + (size_t) m * size;
+				if (bounds == NULL) {
+					for (int i=0; i < size; i++) column[i] = (Real) population[i]->obj[m];
+				} else {
+					for (int i=0; i < size; i++) column[i] = (Real) bounds->normalize (m, population[i]->obj[m]);
+				}
+			}
+			row.resize (size);
+		}
+
+		/**
+		 * row[j] = quadrado da distância entre i e j, j em [begin, n).
+		 */
+		void distances (int i, int begin) {
+			const int M = Info::OBJECTIVES;
+			Real * r = row.data ();
+			for (int j=begin; j < n; j++) r[j] = 0;
+			for (int m=0; m < M; m++) {
+				const Real * column = &columns[(size_t) m * n];
+				const Real x = column[i];
+				for (int j=begin; j < n; j++) {
+					Real d = x - column[j];
+					r[j] += d * d;
+				}
+			}
+		}
+
+		void kthNearest (int k, std::vector<double> & out) {
+			out.resize (n);
+			if (n == 0) return;
+			k = std::min (k, n - 1);
+			for (int i=0; i < n; i++) {
+				distances (i, 0);
+				std::nth_element (row.begin (), row.begin () + k, row.end ());
+				out[i] = row[k];
+			}
+		}
+
+		void beginTruncation () {
+			alive.assign (n, 1);
+			nearest.resize (n);
+			neighbour.resize (n);
+			for (int i=0; i < n; i++) update (i);
+		}
+
+		/**
+		 * Recalcula o vizinho mais próximo de i entre os vetores
+		 * seguintes presentes (o primeiro em caso de empate).
+		 */
+		void update (int i) {
+			nearest[i] = std::numeric_limits<Real>::max ();
+			neighbour[i] = -1;
+			if (i + 1 >= n) return;
+
+			distances (i, i + 1);
+			for (int j=i+1; j < n; j++) {
+				if (alive[j] && row[j] < nearest[i]) {
+					nearest[i] = row[j];
+					neighbour[i] = j;
+				}
+			}
+		}
+
+		int closest () const {
+			int best = -1;
+			Real min = std::numeric_limits<Real>::max ();
+			for (int i=0; i < n; i++) {
+				if (!alive[i]) continue;
+				if (best < 0) best = i;
+				if (nearest[i] < min) {
+					min = nearest[i];
+					best = i;
+				}
+			}
+			return best;
+		}
+
+		void remove (int p) {
+			alive[p] = 0;
+			for (int i=0; i < p; i++) {
+				if (alive[i] && neighbour[i] == p) update (i);
+			}
+		}
+
+		int n;
+		std::vector<Real> columns;
+		std::vector<Real> row;
+
+		std::vector<char> alive;
+		std::vector<Real> nearest;
+		std::vector<int> neighbour;
+	};
+
+	bool m_single;
+	int m_size;
+	Store<float> m_float;
+	Store<double> m_double;
+};
+
+#endif
@@ -0,0 +1,419 @@
+#ifndef _DOMINANCE_SORT_H_
+#define _DOMINANCE_SORT_H_
+
+#include <vector>
+#include <algorithm>
+
+#include "thread_pool.h"
+
+/**
+ * Contagem de dominância para populações grandes.
+ *
+ * Para cada vetor calcula quantos vetores o dominam (o rank utilizado
+ * pelo Nsga2) ou apenas se algum o domina (MultiObjective::filter).
+ *
+ * Os vetores são copiados para um buffer contíguo já convertido para
+ * minimização. A contagem de vetores menores ou iguais em todos os
+ * objetivos é feita por divisão e conquista (Bentley; Jensen, 2003):
+ * o conjunto é dividido na mediana de um objetivo, cada metade é
+ * resolvida no mesmo objetivo e os vetores da metade inferior são
+ * contados para a metade superior no objetivo seguinte. Os dois últimos
+ * objetivos são resolvidos por uma varredura com árvore de Fenwick.
+ * Com M objetivos o custo é O(N log^(M-1) N): O(N log N) para dois
+ * objetivos e O(N log² N) para três.
+ *
+ * Com um pool de threads os primeiros níveis da divisão geram tarefas
+ * independentes, cada uma com os seus próprios contadores, somados ao
+ * final pela thread que chamou a contagem. O resultado é o mesmo com
+ * qualquer quantidade de threads. ThreadPool::wait aguarda todas as
+ * tarefas do pool: o pool não deve ser o mesmo em que executa a thread
+ * que chama a contagem.
+ *
+ * A dominância é a mesma de MultiObjective::dominate (fraca: um vetor
+ * que não é pior em nenhum objetivo domina). Entre dois vetores iguais
+ * apenas o de menor índice é dominado, como no laço original do Nsga2;
+ * assim nondominated mantém uma cópia (a de maior índice) de cada vetor
+ * repetido. Um vetor com algum objetivo NaN não domina e não é dominado.
+ *
+ * @see tools/sort_bench.cpp
+ * @see tools/engine_check.cpp
+ * @date 18/10/2026
+ */
+class DominanceSort {
+
+public:
+
+	/**
+	 * @param int quantidade de objetivos
+	 * @param const int * sentido de cada objetivo (1 minimização,
+	 * -1 maximização), como em Info::objconf
+	 * @param ThreadPool * threads utilizadas (NULL: execução serial)
+	 */
+	DominanceSort (int objectives, const int * sense, ThreadPool * pool = NULL)
+		: m_objectives (objectives), m_sense (sense, sense + objectives), m_pool (pool) {}
+
+	void setThreadPool (ThreadPool * pool) { m_pool = pool; }
+
+	/**
+	 * counts[i] recebe a quantidade de vetores que dominam o vetor i
+	 * de values (size vetores, um por linha).
+	 */
+	void count (const double * values, int size, std::vector<int> & counts) {
+		prepare (size, [values, this] (int i) { return values + (size_t) i * m_objectives; });
+		run (counts);
+	}
+
+	/**
+	 * Contagem de dominância entre os indivíduos population[index[k]],
+	 * k em [0, size). counts[k] corresponde a index[k].
+	 */
+	template <class Individual>
+	void count (Individual ** population, const int * index, int size, std::vector<int> & counts) {
+		prepare (size, [population, index] (int k) { return (const double *) population[index[k]]->obj; });
+		run (counts);
+	}
+
+	/**
+	 * nondominated[i] recebe 1 se nenhum outro vetor de values domina
+	 * o vetor i.
+	 */
+	void nondominated (const double * values, int size, std::vector<char> & nondominated) {
+		prepare (size, [values, this] (int i) { return values + (size_t) i * m_objectives; });
+
+		std::vector<int> counts;
+		run (counts);
+
+		nondominated.resize (size);
+		for (int i=0; i < size; i++) nondominated[i] = counts[i] == 0;
+	}
+
+private:
+
+	//papel de um vetor em um subproblema: contado, consultado ou ambos
+	enum { POINT = 1, QUERY = 2 };
+
+	//subproblemas com até SMALL vetores são resolvidos por comparação direta
+	static const int SMALL = 32;
+
+	struct Item {
+		int row;	//linha em m_rows
+		int slot;	//contador da tarefa
+		int role;
+	};
+
+	/**
+	 * Subproblema independente: os vetores com papel POINT são contados
+	 * para os vetores com papel QUERY nos objetivos [dimension, M).
+	 */
+	struct Task {
+		std::vector<Item> items;
+		int dimension;
+		std::vector<int> counts;
+	};
+
+	/**
+	 * Copia os vetores para m_rows, convertidos para minimização.
+	 */
+	template <class Row>
+	void prepare (int size, const Row & row) {
+
+		const int M = m_objectives;
+		m_size = size;
+
+		m_rows.resize ((size_t) size * M);
+		for (int i=0; i < size; i++) {
+			const double * source = row (i);
+			double * target = &m_rows[(size_t) i * M];
+			for (int j=0; j < M; j++) target[j] = source[j] * m_sense[j];
+		}
+	}
+
+	double value (const Item & item, int k) const {
+		return m_rows[(size_t) item.row * m_objectives + k];
+	}
+
+	/**
+	 * counts[i]: vetores menores ou iguais ao vetor i em todos os
+	 * objetivos, exceto o próprio vetor e as cópias de maior índice.
+	 */
+	void run (std::vector<int> & counts) {
+
+		const int M = m_objectives;
+		counts.assign (m_size, 0);
+
+		//vetores com NaN ficam fora da contagem
+		std::vector<Item> items;
+		items.reserve (m_size);
+		for (int i=0; i < m_size; i++) {
+			const double * a = &m_rows[(size_t) i * M];
+			int j = 0;
+			while (j < M && a[j] == a[j]) j++;
+			if (j == M) items.push_back (Item {i, 0, POINT | QUERY});
+		}
+		if (items.empty ()) return;
+
+		std::vector<Task *> tasks;
+		tasks.push_back (task (items, 0));
+
+		if (m_pool != NULL && m_pool->size () > 1 && (int) items.size () > 64 * SMALL) {
+			expand (tasks, 4 * m_pool->size ());
+			for (unsigned t=0; t < tasks.size (); t++) {
+				Task * task = tasks[t];
+				m_pool->submit ([this, task] { solve (task); });
+			}
+			m_pool->wait ();
+		} else {
+			solve (tasks[0]);
+		}
+
+		for (unsigned t=0; t < tasks.size (); t++) {
+			for (const Item & item : tasks[t]->items) {
+				if (item.role & QUERY) counts[item.row] += tasks[t]->counts[item.slot];
+			}
+			delete tasks[t];
+		}
+
+		//cada vetor contou a si mesmo; entre vetores iguais apenas os de
+		//maior índice dominam
+		std::sort (items.begin (), items.end (), [this, M] (const Item & a, const Item & b) {
+			const double * x = &m_rows[(size_t) a.row * M];
+			const double * y = &m_rows[(size_t) b.row * M];
+			for (int j=0; j < M; j++) {
+				if (x[j] != y[j]) return x[j] < y[j];
+			}
+			return a.row < b.row;
+		});
+		int earlier = 0;
+		for (unsigned u=0; u < items.size (); u++) {
+			if (u > 0 && std::equal (&m_rows[(size_t) items[u].row * M], &m_rows[(size_t) items[u].row * M] + M,
+					&m_rows[(size_t) items[u - 1].row * M])) earlier++;
+			else earlier = 0;
+			counts[items[u].row] -= 1 + earlier;
+		}
+	}
+
+	/**
+	 * Cria uma tarefa com os vetores de items (contadores renumerados).
+	 */
+	Task * task (const std::vector<Item> & items, int dimension) {
+		Task * t = new Task;
+		t->items = items;
+		t->dimension = dimension;
+		for (unsigned u=0; u < t->items.size (); u++) t->items[u].slot = (int) u;
+		return t;
+	}
+
+	/**
+	 * Divide as maiores tarefas até haver limit tarefas (ou nenhuma
+	 * tarefa a dividir).
+	 */
+	void expand (std::vector<Task *> & tasks, int limit) {
+
+		const int M = m_objectives;
+		while ((int) tasks.size () < limit) {
+
+			int largest = -1;
+			for (unsigned t=0; t < tasks.size (); t++) {
+				if (tasks[t]->dimension >= M - 2 || (int) tasks[t]->items.size () <= 64 * SMALL) continue;
+				if (largest < 0 || tasks[t]->items.size () > tasks[largest]->items.size ()) largest = t;
+			}
+			if (largest < 0) return;
+
+			Task * t = tasks[largest];
+			const int n = (int) t->items.size ();
+			const int k = t->dimension;
+			int b = split (&t->items[0], n, k);
+			if (b == 0) {
+				t->dimension++;
+				continue;
+			}
+
+			std::vector<Item> cross;
+			this->cross (&t->items[0], n, b, cross);
+			std::vector<Item> lower (t->items.begin (), t->items.begin () + b);
+			std::vector<Item> upper (t->items.begin () + b, t->items.end ());
+			delete t;
+
+			tasks[largest] = task (lower, k);
+			tasks.push_back (task (upper, k));
+			if (!cross.empty ()) tasks.push_back (task (cross, k + 1));
+		}
+	}
+
+	void solve (Task * t) {
+		t->counts.assign (t->items.size (), 0);
+		if (!t->items.empty ()) solve (&t->items[0], (int) t->items.size (), t->dimension, &t->counts[0]);
+	}
+
+	/**
+	 * Soma em out[slot] de cada vetor QUERY de items[0, n) a quantidade
+	 * de vetores POINT menores ou iguais nos objetivos [k, M).
+	 */
+	void solve (Item * items, int n, int k, int * out) {
+
+		const int M = m_objectives;
+
+		if (n <= SMALL) {
+			direct (items, n, k, out);
+			return;
+		}
+		if (k == M - 1) {
+			sweep (items, n, k, out);
+			return;
+		}
+		if (k == M - 2) {
+			fenwick (items, n, k, out);
+			return;
+		}
+
+		int b = split (items, n, k);
+		if (b == 0) {
+			//todos iguais no objetivo k
+			solve (items, n, k + 1, out);
+			return;
+		}
+
+		{
+			std::vector<Item> cross;
+			this->cross (items, n, b, cross);
+			if (!cross.empty ()) solve (&cross[0], (int) cross.size (), k + 1, out);
+		}
+		solve (items, b, k, out);
+		solve (items + b, n - b, k, out);
+	}
+
+	/**
+	 * Reorganiza items[0, n) de modo que items[0, b) seja menor ou igual
+	 * a items[b, n) no objetivo k, com b próximo de n / 2 e vetores
+	 * iguais no objetivo k do mesmo lado.
+	 *
+	 * @return int b (zero se todos os vetores são iguais no objetivo k)
+	 */
+	int split (Item * items, int n, int k) {
+
+		Item * middle = items + n / 2;
+		std::nth_element (items, middle, items + n, [this, k] (const Item & a, const Item & b) {
+			return value (a, k) < value (b, k);
+		});
+		const double median = value (*middle, k);
+
+		Item * less = std::partition (items, items + n, [this, k, median] (const Item & a) {
+			return value (a, k) < median;
+		});
+		Item * equal = std::partition (less, items + n, [this, k, median] (const Item & a) {
+			return value (a, k) == median;
+		});
+
+		int b1 = (int) (less - items);
+		int b2 = (int) (equal - items);
+		if (b2 == n) return b1;
+		if (b1 == 0) return b2;
+		return n / 2 - b1 <= b2 - n / 2 ? b1 : b2;
+	}
+
+	/**
+	 * Vetores POINT de items[0, b) e vetores QUERY de items[b, n).
+	 */
+	void cross (const Item * items, int n, int b, std::vector<Item> & cross) {
+
+		int points = 0, queries = 0;
+		for (int i=0; i < b; i++) points += (items[i].role & POINT) != 0;
+		for (int i=b; i < n; i++) queries += (items[i].role & QUERY) != 0;
+		if (points == 0 || queries == 0) return;
+
+		cross.reserve (points + queries);
+		for (int i=0; i < b; i++) {
+			if (items[i].role & POINT) cross.push_back (Item {items[i].row, items[i].slot, POINT});
+		}
+		for (int i=b; i < n; i++) {
+			if (items[i].role & QUERY) cross.push_back (Item {items[i].row, items[i].slot, QUERY});
+		}
+	}
+
+	void direct (const Item * items, int n, int k, int * out) const {
+
+		const int M = m_objectives;
+		for (int q=0; q < n; q++) {
+			if (!(items[q].role & QUERY)) continue;
+			const double * a = &m_rows[(size_t) items[q].row * M];
+
+			int count = 0;
+			for (int p=0; p < n; p++) {
+				if (!(items[p].role & POINT)) continue;
+				const double * b = &m_rows[(size_t) items[p].row * M];
+				int j = k;
+				while (j < M && b[j] <= a[j]) j++;
+				count += j == M;
+			}
+			out[items[q].slot] += count;
+		}
+	}
+
+	/**
+	 * Último objetivo: varredura em ordem crescente.
+	 */
+	void sweep (Item * items, int n, int k, int * out) {
+
+		std::sort (items, items + n, [this, k] (const Item & a, const Item & b) {
+			return value (a, k) < value (b, k);
+		});
+
+		int points = 0;
+		for (int begin=0, end=0; begin < n; begin = end) {
+			while (end < n && value (items[end], k) == value (items[begin], k)) end++;
+			for (int i=begin; i < end; i++) points += (items[i].role & POINT) != 0;
+			for (int i=begin; i < end; i++) {
+				if (items[i].role & QUERY) out[items[i].slot] += points;
+			}
+		}
+	}
+
+	/**
+	 * Dois últimos objetivos: varredura no objetivo k com uma árvore de
+	 * Fenwick sobre o objetivo k + 1.
+	 */
+	void fenwick (Item * items, int n, int k, int * out) {
+
+		std::sort (items, items + n, [this, k] (const Item & a, const Item & b) {
+			return value (a, k) < value (b, k);
+		});
+
+		std::vector<double> keys;
+		keys.reserve (n);
+		for (int i=0; i < n; i++) {
+			if (items[i].role & POINT) keys.push_back (value (items[i], k + 1));
+		}
+		std::sort (keys.begin (), keys.end ());
+		keys.erase (std::unique (keys.begin (), keys.end ()), keys.end ());
+
+		const int size = (int) keys.size ();
+		std::vector<int> tree (size + 1, 0);
+
+		for (int begin=0, end=0; begin < n; begin = end) {
+			while (end < n && value (items[end], k) == value (items[begin], k)) end++;
+
+			for (int i=begin; i < end; i++) {
+				if (!(items[i].role & POINT)) continue;
+				int r = (int) (std::lower_bound (keys.begin (), keys.end (), value (items[i], k + 1)) - keys.begin ()) + 1;
+				for (; r <= size; r += r & -r) tree[r]++;
+			}
+
+			for (int i=begin; i < end; i++) {
+				if (!(items[i].role & QUERY)) continue;
+				int r = (int) (std::upper_bound (keys.begin (), keys.end (), value (items[i], k + 1)) - keys.begin ());
+				int count = 0;
+				for (; r > 0; r -= r & -r) count += tree[r];
+				out[items[i].slot] += count;
+			}
+		}
+	}
+
+	int m_objectives;
+	std::vector<int> m_sense;
+	ThreadPool * m_pool;
+
+	int m_size;
+	std::vector<double> m_rows;
+};
+
+#endif
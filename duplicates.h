@@ -0,0 +1,120 @@
+#ifndef _DUPLICATES_H_
+#define _DUPLICATES_H_
+
+#include <stdint.h>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include "problem_info.h"
+
+/**
+ * Detecção de vetores de objetivos duplicados em O(N) esperado.
+ *
+ * Os vetores de objetivos são quantizados (arredondados para múltiplos
+ * de quantum) e inseridos em uma tabela hash de endereçamento aberto.
+ * Apenas vetores que caem na mesma posição da tabela são comparados
+ * objetivo a objetivo. Todos os objetivos participam da comparação.
+ *
+ * Com quantum igual a zero (padrão) dois vetores são duplicados apenas
+ * se todos os objetivos forem exatamente iguais.
+ *
+ * A chave inclui também a classe do indivíduo: viável ou inviável
+ * (violation > 0) e avaliado ou predito (ScreenedProblem). Indivíduos
+ * de classes diferentes nunca são duplicados entre si, de modo que a
+ * cópia que sobrevive é decidida pelas regras de Deb (Constraints) e
+ * não pela posição na população.
+ *
+ * A tabela é mantida entre chamadas, assim o uso a cada geração não
+ * aloca memória depois da primeira.
+ *
+ * Utilizado pelo Spea2 (fitnessAssign) e pelo Nsga2
+ * (fast_nom_dominated_sort) para que duplicados não ocupem posições
+ * do arquivo ou das primeiras fronteiras.
+ *
+ * @date 18/10/2026
+ */
+class DuplicateFilter {
+
+public:
+	DuplicateFilter (double quantum = 0.0) : m_quantum (quantum) {}
+
+	/**
+	 * Marca em duplicate os indivíduos de population[0, size) cujo
+	 * vetor de objetivos já apareceu, na mesma classe, em uma posição
+	 * anterior. A primeira ocorrência de cada vetor não é marcada.
+	 *
+	 * @return quantidade de duplicados
+	 */
+	template <class Individual>
+	int mark (Individual ** population, int size, std::vector<char> & duplicate) {
+
+		const int M = Info::OBJECTIVES;
+
+		//objetivos seguidos da classe do indivíduo
+		const int W = M + 1;
+
+		duplicate.assign (size, 0);
+
+		size_t capacity = 16;
+		while (capacity < 2 * (size_t) size) capacity <<= 1;
+		m_table.assign (capacity, -1);
+		m_keys.resize ((size_t) size * W);
+
+		int count = 0;
+		for (int i=0; i < size; i++) {
+
+			int64_t * key = &m_keys[(size_t) i * W];
+			quantize (population[i]->obj, key, M);
+			key[M] = (population[i]->violation > 0.0 ? 1 : 0) | (population[i]->predicted ? 2 : 0);
+
+			size_t slot = hash (key, W) & (capacity - 1);
+			while (m_table[slot] != -1) {
+				if (memcmp (&m_keys[(size_t) m_table[slot] * W], key, W * sizeof (int64_t)) == 0) {
+					duplicate[i] = 1;
+					count++;
+					break;
+				}
+				slot = (slot + 1) & (capacity - 1);
+			}
+
+			if (!duplicate[i]) m_table[slot] = i;
+		}
+
+		return count;
+	}
+
+private:
+
+	/**
+	 * Converte o vetor de objetivos em inteiros comparáveis. Sem
+	 * quantização os bits do double são utilizados diretamente
+	 * (com -0.0 igual a 0.0).
+	 */
+	void quantize (const double * obj, int64_t * key, int M) const {
+		for (int j=0; j < M; j++) {
+			if (m_quantum > 0.0) {
+				key[j] = (int64_t) std::floor (obj[j] / m_quantum + 0.5);
+			} else {
+				double value = obj[j] == 0.0 ? 0.0 : obj[j];
+				memcpy (&key[j], &value, sizeof (double));
+			}
+		}
+	}
+
+	static size_t hash (const int64_t * key, int M) {
+		uint64_t h = 0x9e3779b97f4a7c15ULL;
+		for (int j=0; j < M; j++) {
+			h ^= (uint64_t) key[j];
+			h *= 0xff51afd7ed558ccdULL;
+			h ^= h >> 32;
+		}
+		return (size_t) h;
+	}
+
+	double m_quantum;
+	std::vector<int> m_table;
+	std::vector<int64_t> m_keys;
+};
+
+#endif
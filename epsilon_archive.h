@@ -0,0 +1,286 @@
+#ifndef _EPSILON_ARCHIVE_H_
+#define _EPSILON_ARCHIVE_H_
+
+#include <stdint.h>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+
+#include "problem_info.h"
+#include "result_writer.h"
+
+/**
+ * Arquivo de ε-dominância por caixas (Laumanns et al., 2002) para
+ * execuções longas.
+ *
+ * O espaço de objetivos (convertido para minimização por Info::objconf)
+ * é dividido em caixas de lado ε_j no objetivo j; a caixa de um vetor f
+ * é b_j = floor (f_j / ε_j). O arquivo guarda no máximo um vetor por
+ * caixa e apenas caixas não dominadas por outras caixas:
+ *
+ *  - na mesma caixa fica o vetor que domina o outro ou, se nenhum domina,
+ *    o mais próximo do canto inferior da caixa;
+ *  - um vetor cuja caixa é dominada por uma caixa do arquivo é recusado;
+ *  - um vetor aceito remove os vetores de caixas que a sua caixa domina.
+ *
+ * Assim o tamanho do arquivo é limitado pela grade ε (no máximo
+ * prod_j (range_j / ε_j) caixas, muito menos em uma fronteira) e todo
+ * vetor viável visto durante a execução é ε-dominado por algum vetor do
+ * arquivo.
+ *
+ * Pela dominância com restrições (veja Constraints) todo vetor viável
+ * domina os inviáveis, de modo que o arquivo guarda apenas vetores
+ * viáveis (violação zero); vetores inviáveis são recusados.
+ *
+ * As caixas ocupadas ficam em uma tabela hash (caixa -> vetor): um vetor
+ * que cai em uma caixa já ocupada é resolvido em O(1) esperado. Um vetor
+ * de uma caixa nova é comparado com as caixas do arquivo, que é pequeno
+ * por construção.
+ *
+ * Os valores de ε são lidos por ProblemInfo do arquivo de configuração
+ * de ε, ao lado do arquivo de configuração dos objetivos:
+ *
+ *		ProblemInfo info ("instancia.txt", "objconf.txt", "epsilon.txt");
+ *		EpsilonArchive archive;
+ *		nsga2.setArchive (&archive);
+ *		nsga2.run ();
+ *		archive.printArc (writer, 0);
+ *
+ * @date 18/10/2026
+ */
+class EpsilonArchive {
+
+public:
+
+	/**
+	 * @param const double * ε de cada objetivo (maior que zero); por
+	 * padrão os valores lidos por ProblemInfo (Info::epsilon). Sem ε
+	 * configurado a execução é encerrada, como na leitura do objconf.
+	 */
+	EpsilonArchive (const double * epsilon = Info::epsilon)
+		: m_objectives (Info::OBJECTIVES), m_box (Info::OBJECTIVES) {
+
+		if (epsilon == NULL) {
+			fprintf (stderr, "EpsilonArchive: ε não configurado\n");
+			exit (1);
+		}
+		m_epsilon.assign (epsilon, epsilon + m_objectives);
+	}
+
+	/**
+	 * Oferece o vetor obj, de violação violation, ao arquivo. Vetores
+	 * inviáveis e vetores com algum objetivo NaN ou infinito (que não
+	 * pertencem a nenhuma caixa) são recusados.
+	 *
+	 * @return bool verdadeiro se o vetor foi guardado
+	 */
+	bool insert (const double * obj, double violation = 0.0) {
+
+		const int M = m_objectives;
+		if (!(violation <= 0.0)) return false;
+		for (int j=0; j < M; j++) {
+			if (!std::isfinite (obj[j])) return false;
+		}
+		for (int j=0; j < M; j++) {
+			m_box[j] = (int64_t) std::floor (obj[j] * Info::objconf[j] / m_epsilon[j]);
+		}
+
+		//caixa ocupada: apenas o ocupante é comparado
+		std::unordered_map<Box, int, BoxHash>::iterator it = m_slots.find (m_box);
+		if (it != m_slots.end ()) {
+			int slot = it->second;
+			const double * old = row (slot);
+
+			int relation = compare (obj, old);
+			if (relation > 0 || (relation == 0 && corner (obj) < corner (old))) {
+				std::copy (obj, obj + M, m_values.begin () + (size_t) slot * M);
+				return true;
+			}
+			return false;
+		}
+
+		//caixa nova: recusada se alguma caixa do arquivo a domina
+		for (int s=0; s < size (); s++) {
+			if (dominates (box (s), &m_box[0])) return false;
+		}
+
+		//remove os vetores das caixas dominadas pela nova caixa
+		for (int s=0; s < size (); ) {
+			if (dominates (&m_box[0], box (s))) remove (s);
+			else s++;
+		}
+
+		m_slots[m_box] = size ();
+		m_values.insert (m_values.end (), obj, obj + M);
+		m_boxes.insert (m_boxes.end (), m_box.begin (), m_box.end ());
+		return true;
+	}
+
+	/**
+	 * Oferece os vetores values (rows vetores, um por linha), de
+	 * violações violation (todos viáveis se NULL).
+	 *
+	 * @return int quantidade de vetores guardados
+	 */
+	int insert (const double * values, int rows, const double * violation = NULL) {
+		int accepted = 0;
+		for (int i=0; i < rows; i++) {
+			accepted += insert (values + (size_t) i * m_objectives, violation ? violation[i] : 0.0);
+		}
+		return accepted;
+	}
+
+	void clear () {
+		m_values.clear ();
+		m_boxes.clear ();
+		m_slots.clear ();
+	}
+
+	int size () const { return (int) (m_values.size () / m_objectives); }
+
+	/**
+	 * Vetor de objetivos i do arquivo (em qualquer ordem).
+	 */
+	const double * row (int i) const { return &m_values[(size_t) i * m_objectives]; }
+
+	/**
+	 * Vetores do arquivo, um por linha.
+	 */
+	const std::vector<double> & values () const { return m_values; }
+
+	/**
+	 * Caixas dos vetores do arquivo, na ordem de values.
+	 */
+	const std::vector<int64_t> & boxes () const { return m_boxes; }
+
+	/**
+	 * Substitui o conteúdo do arquivo por size vetores values e as suas
+	 * caixas boxes, como gravados por um checkpoint. Se alguma caixa não
+	 * corresponde ao ε corrente (ε alterado entre as execuções) ou se
+	 * repete, os vetores são oferecidos novamente por insert.
+	 */
+	void restore (const double * values, const int64_t * boxes, int size) {
+
+		const int M = m_objectives;
+		clear ();
+
+		bool same = true;
+		for (size_t k=0; same && k < (size_t) size * M; k++) {
+			int j = (int) (k % M);
+			same = std::isfinite (values[k]) &&
+					(int64_t) std::floor (values[k] * Info::objconf[j] / m_epsilon[j]) == boxes[k];
+		}
+
+		if (same) {
+			m_values.assign (values, values + (size_t) size * M);
+			m_boxes.assign (boxes, boxes + (size_t) size * M);
+			for (int s=0; s < size; s++) m_slots[Box (box (s), box (s) + M)] = s;
+			if ((int) m_slots.size () == size) return;
+			clear ();
+		}
+
+		for (int i=0; i < size; i++) insert (values + (size_t) i * M);
+	}
+
+	/**
+	 * Envia os vetores do arquivo para um escritor assíncrono.
+	 */
+	void printArc (ResultWriter & writer, int generation) {
+		ResultWriter::Block * block = writer.acquire (generation);
+		for (int i=0; i < size (); i++) block->add (row (i));
+		writer.push (block);
+	}
+
+private:
+
+	typedef std::vector<int64_t> Box;
+
+	struct BoxHash {
+		size_t operator() (const Box & box) const {
+			uint64_t h = 0x9e3779b97f4a7c15ULL;
+			for (unsigned j=0; j < box.size (); j++) {
+				h ^= (uint64_t) box[j];
+				h *= 0xff51afd7ed558ccdULL;
+				h ^= h >> 32;
+			}
+			return (size_t) h;
+		}
+	};
+
+	const int64_t * box (int slot) const { return &m_boxes[(size_t) slot * m_objectives]; }
+
+	/**
+	 * Caixa a domina a caixa b: não é maior em nenhum objetivo e é
+	 * diferente de b.
+	 */
+	bool dominates (const int64_t * a, const int64_t * b) const {
+		bool less = false;
+		for (int j=0; j < m_objectives; j++) {
+			if (a[j] > b[j]) return false;
+			if (a[j] < b[j]) less = true;
+		}
+		return less;
+	}
+
+	/**
+	 * 1 se a domina b, -1 se b domina a ou se são iguais, 0 se são
+	 * incomparáveis (vetores da mesma caixa).
+	 */
+	int compare (const double * a, const double * b) const {
+		bool better = false, worse = false;
+		for (int j=0; j < m_objectives; j++) {
+			double x = a[j] * Info::objconf[j];
+			double y = b[j] * Info::objconf[j];
+			if (x < y) better = true;
+			else if (x > y) worse = true;
+		}
+		if (better && !worse) return 1;
+		if (!better) return -1;
+		return 0;
+	}
+
+	/**
+	 * Quadrado da distância, em unidades de ε, ao canto inferior da caixa
+	 * corrente (m_box).
+	 */
+	double corner (const double * obj) const {
+		double sum = 0.0;
+		for (int j=0; j < m_objectives; j++) {
+			double d = obj[j] * Info::objconf[j] / m_epsilon[j] - (double) m_box[j];
+			sum += d * d;
+		}
+		return sum;
+	}
+
+	/**
+	 * Remove o vetor do slot s; o último vetor passa a ocupar o slot s.
+	 */
+	void remove (int s) {
+		const int M = m_objectives;
+		int last = size () - 1;
+
+		m_slots.erase (Box (box (s), box (s) + M));
+		if (s != last) {
+			std::copy (row (last), row (last) + M, m_values.begin () + (size_t) s * M);
+			std::copy (box (last), box (last) + M, m_boxes.begin () + (size_t) s * M);
+			m_slots[Box (box (s), box (s) + M)] = s;
+		}
+		m_values.resize ((size_t) last * M);
+		m_boxes.resize ((size_t) last * M);
+	}
+
+	int m_objectives;
+	std::vector<double> m_epsilon;
+
+	std::vector<double> m_values;
+	std::vector<int64_t> m_boxes;
+	std::unordered_map<Box, int, BoxHash> m_slots;
+
+	//caixa do vetor em inserção (reutilizada nas buscas)
+	Box m_box;
+};
+
+#endif
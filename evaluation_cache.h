@@ -0,0 +1,354 @@
+#ifndef _EVALUATION_CACHE_H_
+#define _EVALUATION_CACHE_H_
+
+#include <stdint.h>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+#include "generic_individual.h"
+#include "random.h"
+#include "variation.h"
+#include "surrogate.h"
+
+/**
+ * Cache de avaliações de objetivos indexado pelo hash do genótipo.
+ *
+ * O cache é dividido em partições (shards), cada uma com o seu mutex,
+ * de modo que várias execuções (ou threads) podem consultá-lo ao mesmo
+ * tempo com pouca disputa. Cada partição possui uma quantidade fixa de
+ * entradas, definida pelo orçamento de memória, e utiliza o algoritmo
+ * CLOCK para escolher a entrada a ser descartada quando está cheia.
+ *
+ * Cada entrada guarda os objetivos e a violação das restrições.
+ * A chave é o hash de 64 bits do genótipo (Problem::hash) e cada entrada
+ * guarda também um segundo hash, independente, da serialização do
+ * genótipo (Problem::write), conferido na consulta. O genótipo não é
+ * guardado: uma avaliação só é reaproveitada se os dois hashes coincidem,
+ * e um hash de má qualidade apenas reduz os acertos do cache.
+ *
+ * @see CachedProblem
+ * @date 18/10/2026
+ */
+class EvaluationCache {
+
+public:
+
+	/**
+	 * Memória aproximada de um nó de std::unordered_map<uint64_t, size_t>
+	 * na libstdc++: ponteiro para o próximo nó, par (chave, posição) e
+	 * hash guardado (32 bytes), mais o cabeçalho do malloc e o ponteiro
+	 * do balde.
+	 */
+	static const size_t NODE_BYTES = 48;
+
+	/**
+	 * @param size_t orçamento de memória em bytes
+	 * @param int quantidade de partições
+	 */
+	EvaluationCache (size_t budget = 64 << 20, int shards = 16)
+		: m_objectives (Info::OBJECTIVES), m_width (Info::OBJECTIVES + 1), m_shards (shards),
+		  m_hits (0), m_misses (0), m_evictions (0)
+	{
+		//chave + conferência + objetivos + violação + bit de referência + nó da tabela hash
+		size_t entry = 2 * sizeof (uint64_t) + m_width * sizeof (double) + 1 + NODE_BYTES;
+		size_t capacity = budget / entry / shards;
+		if (capacity < 1) capacity = 1;
+
+		for (int s=0; s < shards; s++) {
+			m_shards[s].capacity = capacity;
+			m_shards[s].keys.reserve (capacity);
+			m_shards[s].checks.reserve (capacity);
+			m_shards[s].values.reserve (capacity * m_width);
+			m_shards[s].referenced.reserve (capacity);
+			m_shards[s].index.reserve (capacity);
+		}
+	}
+
+	/**
+	 * Procura a avaliação do genótipo de hash key e de conferência check.
+	 * Se encontrada, os objetivos são copiados para obj, a violação para
+	 * violation e a função retorna verdadeiro. Uma entrada com a mesma
+	 * chave e outra conferência (colisão) é uma falta.
+	 */
+	bool lookup (uint64_t key, uint64_t check, double * obj, double & violation) {
+
+		Shard & shard = m_shards[key % m_shards.size ()];
+		std::lock_guard<std::mutex> lock (shard.mutex);
+
+		std::unordered_map<uint64_t, size_t>::const_iterator it = shard.index.find (key);
+		if (it == shard.index.end () || shard.checks[it->second] != check) {
+			m_misses.fetch_add (1, std::memory_order_relaxed);
+			return false;
+		}
+
+		const double * entry = &shard.values[it->second * m_width];
+		memcpy (obj, entry, m_objectives * sizeof (double));
+		violation = entry[m_objectives];
+		shard.referenced[it->second] = 1;
+		m_hits.fetch_add (1, std::memory_order_relaxed);
+		return true;
+	}
+
+	/**
+	 * Insere a avaliação (obj, violation) do genótipo de hash key e de
+	 * conferência check. Uma entrada com a mesma chave e outra conferência
+	 * é substituída. Se a partição estiver cheia, uma entrada é descartada
+	 * pelo algoritmo CLOCK.
+	 */
+	void insert (uint64_t key, uint64_t check, const double * obj, double violation) {
+
+		Shard & shard = m_shards[key % m_shards.size ()];
+		std::lock_guard<std::mutex> lock (shard.mutex);
+
+		size_t slot;
+		std::unordered_map<uint64_t, size_t>::const_iterator it = shard.index.find (key);
+		if (it != shard.index.end ()) {
+			slot = it->second;
+			if (shard.checks[slot] == check) return;
+			shard.checks[slot] = check;
+		} else if (shard.keys.size () < shard.capacity) {
+			slot = shard.keys.size ();
+			shard.keys.push_back (key);
+			shard.checks.push_back (check);
+			shard.values.resize (shard.values.size () + m_width);
+			shard.referenced.push_back (0);
+			shard.index[key] = slot;
+		} else {
+			//CLOCK: avança o ponteiro limpando os bits de referência
+			while (shard.referenced[shard.hand]) {
+				shard.referenced[shard.hand] = 0;
+				shard.hand = (shard.hand + 1) % shard.capacity;
+			}
+			slot = shard.hand;
+			shard.hand = (shard.hand + 1) % shard.capacity;
+
+			shard.index.erase (shard.keys[slot]);
+			shard.keys[slot] = key;
+			shard.checks[slot] = check;
+			shard.index[key] = slot;
+			m_evictions.fetch_add (1, std::memory_order_relaxed);
+		}
+
+		double * entry = &shard.values[slot * m_width];
+		memcpy (entry, obj, m_objectives * sizeof (double));
+		entry[m_objectives] = violation;
+	}
+
+	uint64_t hits () const { return m_hits.load (); }
+	uint64_t misses () const { return m_misses.load (); }
+	uint64_t evictions () const { return m_evictions.load (); }
+
+	/**
+	 * Quantidade de entradas armazenadas.
+	 */
+	size_t size () {
+		size_t total = 0;
+		for (unsigned s=0; s < m_shards.size (); s++) {
+			std::lock_guard<std::mutex> lock (m_shards[s].mutex);
+			total += m_shards[s].keys.size ();
+		}
+		return total;
+	}
+
+	void printStatistics () {
+		uint64_t total = hits () + misses ();
+		printf ("Cache: %llu hits %llu misses %llu evictions (%.1f%% hits)\n",
+				(unsigned long long) hits (), (unsigned long long) misses (),
+				(unsigned long long) evictions (),
+				total ? 100.0 * hits () / total : 0.0);
+	}
+
+	/**
+	 * Hash de 64 bits de um bloco de memória (FNV-1a seguido de uma
+	 * mistura final). Útil para implementar Problem::hash quando o
+	 * genótipo é armazenado de forma contígua.
+	 */
+	static uint64_t hashBytes (const void * data, size_t size, uint64_t seed = 0) {
+		const unsigned char * p = (const unsigned char *) data;
+		uint64_t h = 0xcbf29ce484222325ULL ^ seed;
+		for (size_t i=0; i < size; i++) {
+			h ^= p[i];
+			h *= 0x100000001b3ULL;
+		}
+		h ^= h >> 33;
+		h *= 0xff51afd7ed558ccdULL;
+		h ^= h >> 33;
+		return h;
+	}
+
+private:
+	struct Shard {
+		Shard () : capacity (0), hand (0) {}
+
+		std::mutex mutex;
+		size_t capacity;
+		size_t hand;
+
+		std::vector<uint64_t> keys;
+		std::vector<uint64_t> checks;
+		std::vector<double> values;
+		std::vector<char> referenced;
+		std::unordered_map<uint64_t, size_t> index;
+	};
+
+	int m_objectives;
+	int m_width;
+	std::vector<Shard> m_shards;
+
+	std::atomic<uint64_t> m_hits;
+	std::atomic<uint64_t> m_misses;
+	std::atomic<uint64_t> m_evictions;
+};
+
+/**
+ * Política de problema que adiciona um cache de avaliações a outra
+ * política. Os algoritmos são parametrizados por CachedProblem<Problem>
+ * sem nenhuma outra alteração:
+ *
+ *		MulticastProblem policy (Info::mproblem);
+ *		EvaluationCache cache (256 << 20);
+ *		CachedProblem<MulticastProblem> problem (policy, cache);
+ *		Nsga2<CachedProblem<MulticastProblem> > nsga2 (problem, 100, 500);
+ *
+ * Apenas os indivíduos de um lote que não estão no cache são repassados
+ * para Problem::evaluate, ainda em um único lote. A política original
+ * deve fornecer uint64_t hash (const genotype_type &) e write, cuja
+ * serialização dá o hash de conferência das entradas.
+ *
+ * Indivíduos marcados como preditos pela política original
+ * (GenericIndividual::predicted, veja ScreenedProblem) não entram no
+ * cache. Veja em ScreenedProblem a ordem recomendada das duas políticas.
+ *
+ * Cópias de CachedProblem compartilham o mesmo cache (por exemplo, as
+ * execuções de um Experiment).
+ */
+template <class Problem>
+class CachedProblem {
+
+public:
+	typedef typename Problem::genotype_type genotype_type;
+	typedef GenericIndividual<genotype_type> Individual;
+
+	CachedProblem (Problem & problem, EvaluationCache & cache)
+		: m_problem (problem), m_cache (&cache) {}
+
+	void create (genotype_type & genotype, Random & random) {
+		m_problem.create (genotype, random);
+	}
+
+	void crossover (const genotype_type & p1, const genotype_type & p2,
+					genotype_type & child, Random & random) {
+		m_problem.crossover (p1, p2, child, random);
+	}
+
+	void mutation (genotype_type & genotype, Random & random) {
+		m_problem.mutation (genotype, random);
+	}
+
+	void recombine (Individual ** p1, Individual ** p2, Individual ** children,
+					int size, double p_cross, double p_mut, Random & random) {
+		Variation::recombine (m_problem, p1, p2, children, size, p_cross, p_mut, random);
+	}
+
+	void neighbour (const genotype_type & source, genotype_type & target, Random & random) {
+		Variation::neighbour (m_problem, source, target, random);
+	}
+
+	void evaluate (Individual ** individuals, int size) {
+
+		if (lookup (individuals, size)) {
+			//nas faltas a marca é refeita pela política original
+			for (unsigned i=0; i < m_pending.size (); i++) m_pending[i]->predicted = false;
+			m_problem.evaluate (&m_pending[0], (int) m_pending.size ());
+			store ();
+		}
+	}
+
+	/**
+	 * Avaliação real dos indivíduos preditos (veja ScreenedProblem):
+	 * as faltas do cache são confirmadas pela política original.
+	 */
+	void confirm (Individual ** individuals, int size) {
+
+		if (lookup (individuals, size)) {
+			Screening::confirm (m_problem, &m_pending[0], (int) m_pending.size ());
+			store ();
+		}
+	}
+
+	uint64_t hash (const genotype_type & genotype) {
+		return m_problem.hash (genotype);
+	}
+
+	void write (const genotype_type & genotype, std::vector<char> & buffer) {
+		m_problem.write (genotype, buffer);
+	}
+
+	void read (const char * data, size_t size, genotype_type & genotype) {
+		m_problem.read (data, size, genotype);
+	}
+
+private:
+	/**
+	 * Preenche os indivíduos encontrados no cache e guarda as faltas em
+	 * m_pending, com a marca de predição inalterada.
+	 *
+	 * @return bool verdadeiro se há faltas
+	 */
+	bool lookup (Individual ** individuals, int size) {
+
+		m_pending.clear ();
+		m_keys.clear ();
+		m_checks.clear ();
+
+		for (int i=0; i < size; i++) {
+			uint64_t key = m_problem.hash (individuals[i]->genotype);
+			uint64_t check = this->check (individuals[i]->genotype);
+
+			//avaliações do cache são reais
+			if (m_cache->lookup (key, check, individuals[i]->obj, individuals[i]->violation)) {
+				individuals[i]->predicted = false;
+			} else {
+				m_pending.push_back (individuals[i]);
+				m_keys.push_back (key);
+				m_checks.push_back (check);
+			}
+		}
+
+		return !m_pending.empty ();
+	}
+
+	/**
+	 * Guarda no cache as faltas avaliadas de verdade.
+	 */
+	void store () {
+		for (unsigned i=0; i < m_pending.size (); i++) {
+			if (m_pending[i]->predicted) continue;
+			m_cache->insert (m_keys[i], m_checks[i], m_pending[i]->obj, m_pending[i]->violation);
+		}
+	}
+
+	/**
+	 * Hash de conferência: hash da serialização do genótipo, com outra
+	 * semente que a de hashBytes em Problem::hash.
+	 */
+	uint64_t check (const genotype_type & genotype) {
+		m_buffer.clear ();
+		m_problem.write (genotype, m_buffer);
+		return EvaluationCache::hashBytes (m_buffer.data (), m_buffer.size (), 0x9e3779b97f4a7c15ULL);
+	}
+
+	Problem m_problem;
+	EvaluationCache * m_cache;
+
+	std::vector<Individual *> m_pending;
+	std::vector<uint64_t> m_keys;
+	std::vector<uint64_t> m_checks;
+	std::vector<char> m_buffer;
+};
+
+#endif
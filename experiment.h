@@ -0,0 +1,201 @@
+#ifndef _EXPERIMENT_H_
+#define _EXPERIMENT_H_
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <limits>
+#include <chrono>
+#include <sstream>
+#include <memory>
+
+#include "problem_info.h"
+#include "thread_pool.h"
+#include "result_writer.h"
+
+/**
+ * Resumo de uma execução de um experimento.
+ */
+struct RunSummary {
+	int run;
+	uint64_t seed;
+	double seconds;
+
+	/**
+	 * Quantidade de indivíduos não dominados ao final da execução.
+	 */
+	int front_size;
+
+	/**
+	 * Menor e maior valor de cada objetivo na fronteira final
+	 * (pontos ideal e nadir da fronteira).
+	 */
+	std::vector<double> ideal;
+	std::vector<double> nadir;
+};
+
+/**
+ * Executa várias execuções independentes de um algoritmo sobre a
+ * mesma instância, em paralelo e dentro do mesmo processo.
+ *
+ * A instância e a configuração dos objetivos (ProblemInfo, Info::objconf,
+ * Info::OBJECTIVES) são carregadas uma única vez antes do experimento e
+ * apenas lidas durante as execuções. Cada execução recebe:
+ *
+ *  - uma cópia da política de problema. A cópia deve compartilhar os
+ *    dados da instância apenas para leitura (por exemplo, por ponteiro);
+ *  - uma semente própria, derivada da semente do experimento, de modo
+ *    que cada execução possui o seu fluxo de números aleatórios;
+ *  - um arquivo de saída próprio (prefixo_r<execução>), se configurado,
+ *    entregue ao algoritmo antes de run(). As fronteiras são gravadas a
+ *    cada output_interval gerações da configuração e ao fim da execução.
+ *
+ * O algoritmo é criado por uma função fornecida pelo usuário:
+ *
+ *		Experiment<MulticastProblem> exp (problem, 30, 8);
+ *		exp.setOutput ("resultados/b30");
+ *		exp.run ([] (MulticastProblem & p, uint64_t seed) {
+ *			return new Nsga2<MulticastProblem> (p, 100, 500, 0.9, 0.1, seed);
+ *		});
+ *		exp.printSummary ("resultados/b30_summary.txt");
+ *
+ * Com uma configuração de execução (RunConfig) cada execução recebe uma
+ * cópia da configuração com a sua semente:
+ *
+ *		exp.run ([&config] (MulticastProblem & p, uint64_t seed) {
+ *			return new Nsga2<MulticastProblem> (p, config.seeded (seed));
+ *		});
+ *
+ * Os objetivos da configuração devem ser os de Info, utilizados no
+ * resumo e nos arquivos de saída do experimento, e a configuração não
+ * deve definir output, que seria o mesmo arquivo em todas as execuções.
+ *
+ * O algoritmo retornado deve fornecer run(), setOutput (ResultWriter *)
+ * e nondominated (std::vector<double> &).
+ *
+ * @date 18/10/2026
+ */
+template <class Problem>
+class Experiment {
+
+public:
+
+	/**
+	 * @param Problem política de problema compartilhada
+	 * @param int quantidade de execuções
+	 * @param int quantidade de threads (0 indica todos os núcleos)
+	 * @param uint64_t semente do experimento
+	 */
+	Experiment (Problem & problem, int runs, int threads = 0, uint64_t seed = 1)
+		: m_problem (problem), m_runs (runs), m_threads (threads), m_seed (seed),
+		  m_format (Output::PISA) {}
+
+	/**
+	 * Define o prefixo dos arquivos de saída de cada execução. Sem
+	 * prefixo as fronteiras não são gravadas, apenas resumidas.
+	 */
+	void setOutput (const std::string & prefix, Output::Format format = Output::PISA) {
+		m_prefix = prefix;
+		m_format = format;
+	}
+
+	/**
+	 * Executa todas as execuções e aguarda o término.
+	 */
+	template <class Factory>
+	void run (Factory make) {
+
+		m_summary.assign (m_runs, RunSummary ());
+
+		ThreadPool pool (m_threads);
+		for (int r=0; r < m_runs; r++) {
+			pool.submit ([this, r, &make] { execute (r, make); });
+		}
+		pool.wait ();
+	}
+
+	const std::vector<RunSummary> & summary () const {
+		return m_summary;
+	}
+
+	/**
+	 * Grava o resumo das execuções, uma linha por execução:
+	 *
+	 *		run seed seconds front_size min_0 max_0 ... min_M max_M
+	 */
+	void printSummary (const std::string & file) {
+
+		FILE * out = fopen (file.c_str (), "w");
+		if (out == NULL) return;
+
+		fprintf (out, "run seed seconds front_size");
+		for (int j=0; j < Info::OBJECTIVES; j++) fprintf (out, " min_%d max_%d", j, j);
+		fprintf (out, "\n");
+
+		for (unsigned i=0; i < m_summary.size (); i++) {
+			const RunSummary & s = m_summary[i];
+			fprintf (out, "%d %llu %.3f %d", s.run, (unsigned long long) s.seed,
+					s.seconds, s.front_size);
+			for (unsigned j=0; j < s.ideal.size (); j++) {
+				fprintf (out, " %.17g %.17g", s.ideal[j], s.nadir[j]);
+			}
+			fprintf (out, "\n");
+		}
+		fclose (out);
+	}
+
+private:
+
+	template <class Factory>
+	void execute (int r, Factory & make) {
+
+		RunSummary & s = m_summary[r];
+		s.run = r;
+		s.seed = m_seed + r;
+
+		Problem problem = m_problem;
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now ();
+
+		auto * algorithm = make (problem, s.seed);
+
+		//o escritor da execução recebe as fronteiras durante run()
+		std::unique_ptr<ResultWriter> writer;
+		if (!m_prefix.empty ()) {
+			std::ostringstream name;
+			name << m_prefix << "_r" << r << (m_format == Output::PISA ? ".txt" : ".bin");
+			writer.reset (new ResultWriter (name.str (), m_format, 4, r));
+			algorithm->setOutput (writer.get ());
+		}
+
+		algorithm->run ();
+
+		s.seconds = std::chrono::duration<double> (
+				std::chrono::steady_clock::now () - start).count ();
+
+		std::vector<double> front;
+		const int M = Info::OBJECTIVES;
+		s.front_size = algorithm->nondominated (front);
+		s.ideal.assign (M, std::numeric_limits<double>::max ());
+		s.nadir.assign (M, -std::numeric_limits<double>::max ());
+		for (int i=0; i < s.front_size; i++) {
+			for (int j=0; j < M; j++) {
+				s.ideal[j] = std::min (s.ideal[j], front[i * M + j]);
+				s.nadir[j] = std::max (s.nadir[j], front[i * M + j]);
+			}
+		}
+
+		delete algorithm;
+	}
+
+	Problem & m_problem;
+	int m_runs;
+	int m_threads;
+	uint64_t m_seed;
+
+	std::string m_prefix;
+	Output::Format m_format;
+
+	std::vector<RunSummary> m_summary;
+};
+
+#endif
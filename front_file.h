@@ -0,0 +1,404 @@
+#ifndef _FRONT_FILE_H_
+#define _FRONT_FILE_H_
+
+#include <stdint.h>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include <charconv>
+
+#include "mapped_file.h"
+
+/**
+ * Formato binário colunar para fronteiras (vetores de objetivos).
+ *
+ * Um arquivo possui um cabeçalho seguido de blocos, um bloco por
+ * fronteira gravada. Os valores de cada bloco são armazenados por
+ * coluna (todos os valores do objetivo 0, depois do objetivo 1, ...).
+ * Todas as estruturas estão na ordem nativa de bytes e alinhadas em
+ * 8 bytes, de modo que as colunas de um bloco sem compressão são lidas
+ * diretamente do arquivo mapeado em memória.
+ *
+ *		FileHeader
+ *		int32_t sense[objectives]     configuração dos objetivos (objconf)
+ *		(alinhamento em 8 bytes)
+ *		BlockHeader + payload         repetido para cada fronteira
+ *
+ * Codificação do payload:
+ *
+ *  - RAW: objectives colunas de rows doubles;
+ *  - DELTA: as linhas são ordenadas pelo primeiro objetivo e cada coluna
+ *    guarda o primeiro valor (8 bytes) seguido das diferenças entre os
+ *    padrões de bits de valores consecutivos, em zigzag + varint. Em uma
+ *    fronteira ordenada os valores vizinhos são próximos e as diferenças
+ *    ocupam poucos bytes. A compressão é sem perdas, mas a ordem das
+ *    linhas não é preservada.
+ *
+ * Este cabeçalho não depende das variáveis globais do problema, assim
+ * ele pode ser usado por ferramentas externas (tools/front_convert).
+ *
+ * @date 18/10/2026
+ */
+namespace FrontFile {
+
+	enum {MAGIC = 0x46464f4d, VERSION = 1, BLOCK_MAGIC = 0x4b4c4246};
+	enum Encoding {RAW = 0, DELTA = 1};
+
+	struct FileHeader {
+		uint32_t magic;
+		uint32_t version;
+		uint32_t objectives;
+		uint32_t reserved;
+	};
+
+	struct BlockHeader {
+		uint32_t magic;
+		uint32_t rows;
+		uint32_t encoding;
+		int32_t generation;
+		uint64_t run;
+		uint64_t payload;	//tamanho do payload em bytes (múltiplo de 8)
+	};
+
+	inline size_t align8 (size_t value) {
+		return (value + 7) & ~(size_t)7;
+	}
+
+	inline size_t headerSize (int objectives) {
+		return align8 (sizeof (FileHeader) + objectives * sizeof (int32_t));
+	}
+
+	/**
+	 * Grava o cabeçalho do arquivo. Se sense for NULL todos os
+	 * objetivos são considerados de minimização.
+	 */
+	inline bool writeHeader (FILE * file, int objectives, const int * sense) {
+
+		std::vector<char> buffer (headerSize (objectives), 0);
+		FileHeader header = {MAGIC, VERSION, (uint32_t) objectives, 0};
+		memcpy (&buffer[0], &header, sizeof (header));
+
+		int32_t * s = (int32_t *) &buffer[sizeof (header)];
+		for (int j=0; j < objectives; j++) {
+			s[j] = (sense != NULL ? sense[j] : 1);
+		}
+		return fwrite (&buffer[0], 1, buffer.size (), file) == buffer.size ();
+	}
+
+	inline void putVarint (std::vector<char> & out, uint64_t value) {
+		while (value >= 0x80) {
+			out.push_back ((char) (value | 0x80));
+			value >>= 7;
+		}
+		out.push_back ((char) value);
+	}
+
+	/**
+	 * Lê um varint de [in, end) em value.
+	 *
+	 * @return bool falso se os dados acabam antes do fim do varint ou
+	 * se ele possui mais de 10 bytes
+	 */
+	inline bool getVarint (const unsigned char *& in, const unsigned char * end, uint64_t & value) {
+		value = 0;
+		for (int shift=0; shift < 64 && in < end; shift += 7) {
+			unsigned char byte = *in++;
+			value |= (uint64_t) (byte & 0x7f) << shift;
+			if (!(byte & 0x80)) return true;
+		}
+		return false;
+	}
+
+	/**
+	 * Grava um bloco com rows vetores de objetivos armazenados linha
+	 * a linha em values. scratch é um buffer reaproveitado entre
+	 * chamadas para montar o payload.
+	 */
+	inline bool writeBlock (FILE * file, const double * values, int rows,
+			int objectives, int generation, uint64_t run, Encoding encoding,
+			std::vector<char> & scratch)
+	{
+		scratch.clear ();
+
+		if (encoding == DELTA) {
+
+			std::vector<int> order (rows);
+			std::iota (order.begin (), order.end (), 0);
+			//NaN por último, para que a ordem seja válida com qualquer valor
+			std::sort (order.begin (), order.end (), [&](int a, int b) {
+				double x = values[(size_t) a * objectives];
+				double y = values[(size_t) b * objectives];
+				if (x != x || y != y) return (x != x) != (y != y) ? y != y : a < b;
+				return x < y || (x == y && a < b);
+			});
+
+			for (int j=0; j < objectives; j++) {
+				uint64_t previous = 0;
+				for (int i=0; i < rows; i++) {
+					uint64_t bits;
+					memcpy (&bits, &values[(size_t) order[i] * objectives + j], 8);
+					if (i == 0) {
+						scratch.insert (scratch.end (), (char *) &bits, (char *) &bits + 8);
+					} else {
+						int64_t delta = (int64_t) (bits - previous);
+						putVarint (scratch, ((uint64_t) delta << 1) ^ (uint64_t) (delta >> 63));
+					}
+					previous = bits;
+				}
+			}
+
+		} else {
+
+			scratch.resize ((size_t) rows * objectives * sizeof (double));
+			double * column = (double *) scratch.data ();
+			for (int j=0; j < objectives; j++) {
+				for (int i=0; i < rows; i++) {
+					column[(size_t) j * rows + i] = values[(size_t) i * objectives + j];
+				}
+			}
+		}
+
+		scratch.resize (align8 (scratch.size ()), 0);
+
+		BlockHeader header;
+		header.magic = BLOCK_MAGIC;
+		header.rows = rows;
+		header.encoding = encoding;
+		header.generation = generation;
+		header.run = run;
+		header.payload = scratch.size ();
+
+		return fwrite (&header, sizeof (header), 1, file) == 1 &&
+				(scratch.empty () || fwrite (scratch.data (), 1, scratch.size (), file) == scratch.size ());
+	}
+
+	/**
+	 * Uma fronteira lida de um arquivo. As colunas apontam diretamente
+	 * para o arquivo mapeado (RAW) ou para o buffer decoded (DELTA).
+	 */
+	struct Block {
+		int generation;
+		uint64_t run;
+		int rows;
+		std::vector<const double *> columns;
+		std::vector<double> decoded;
+
+		const double * column (int j) const {
+			return columns[j];
+		}
+
+		double value (int i, int j) const {
+			return columns[j][i];
+		}
+	};
+
+	/**
+	 * Leitor de arquivos de fronteiras. O arquivo é mapeado em memória;
+	 * blocos RAW não são copiados.
+	 *
+	 *		FrontFile::Reader reader ("front.bin");
+	 *		FrontFile::Block block;
+	 *		while (reader.next (block)) { ... }
+	 */
+	class Reader {
+
+	public:
+		Reader (const std::string & file)
+			: m_file (file), m_data (m_file.data ()), m_size (m_file.size ()), m_offset (0) {
+			rewind ();
+		}
+
+		/**
+		 * Leitor de um arquivo já carregado em memória (data deve
+		 * existir enquanto o leitor existir e estar alinhado em 8 bytes).
+		 */
+		Reader (const char * data, size_t size)
+			: m_file (""), m_data (data), m_size (size), m_offset (0) {
+			rewind ();
+		}
+
+		/**
+		 * Retorna verdadeiro se o arquivo possui um cabeçalho válido.
+		 */
+		bool valid () const {
+			if (m_data == NULL || m_size < sizeof (FileHeader)) return false;
+			const FileHeader * h = (const FileHeader *) m_data;
+			return h->magic == MAGIC && h->version == VERSION && h->objectives > 0 &&
+					h->objectives <= (m_size - sizeof (FileHeader)) / sizeof (int32_t) &&
+					m_size >= headerSize (h->objectives);
+		}
+
+		int objectives () const {
+			return ((const FileHeader *) m_data)->objectives;
+		}
+
+		/**
+		 * Configuração dos objetivos gravada no arquivo (1 minimização,
+		 * -1 maximização), no mesmo formato de Info::objconf.
+		 */
+		const int32_t * sense () const {
+			return (const int32_t *) (m_data + sizeof (FileHeader));
+		}
+
+		void rewind () {
+			m_offset = valid () ? headerSize (objectives ()) : m_size;
+		}
+
+		/**
+		 * Lê o próximo bloco. Retorna falso no fim do arquivo ou se
+		 * o bloco estiver corrompido: todas as leituras são limitadas
+		 * ao payload do bloco, que deve estar dentro do arquivo.
+		 */
+		bool next (Block & block) {
+
+			if (m_offset > m_size || m_size - m_offset < sizeof (BlockHeader)) return false;
+
+			const BlockHeader * h = (const BlockHeader *) (m_data + m_offset);
+			const char * payload = m_data + m_offset + sizeof (BlockHeader);
+			if (h->magic != BLOCK_MAGIC || h->payload % 8 != 0 || h->rows > 0x7fffffff ||
+				h->payload > m_size - m_offset - sizeof (BlockHeader)) return false;
+
+			const int M = objectives ();
+			const uint64_t rows = h->rows;
+			block.generation = h->generation;
+			block.run = h->run;
+			block.rows = h->rows;
+			block.columns.resize (M);
+
+			if (h->encoding == RAW) {
+				if (rows > h->payload / sizeof (double) / M) return false;
+				for (int j=0; j < M; j++) {
+					block.columns[j] = (const double *) payload + (size_t) j * rows;
+				}
+			} else if (h->encoding == DELTA) {
+				//cada coluna ocupa ao menos 8 bytes e mais 1 byte por linha
+				if (rows > 0 && rows + 7 > h->payload / M) return false;
+
+				const unsigned char * in = (const unsigned char *) payload;
+				const unsigned char * end = in + h->payload;
+
+				block.decoded.resize ((size_t) rows * M);
+				for (int j=0; j < M; j++) {
+					double * column = block.decoded.data () + (size_t) j * rows;
+					uint64_t bits = 0;
+					for (uint64_t i=0; i < rows; i++) {
+						if (i == 0) {
+							if (end - in < 8) return false;
+							memcpy (&bits, in, 8);
+							in += 8;
+						} else {
+							uint64_t z;
+							if (!getVarint (in, end, z)) return false;
+							bits += (z >> 1) ^ (~(z & 1) + 1);
+						}
+						memcpy (&column[i], &bits, 8);
+					}
+					block.columns[j] = column;
+				}
+			} else {
+				return false;
+			}
+
+			m_offset += sizeof (BlockHeader) + h->payload;
+			return true;
+		}
+
+		/**
+		 * Verdadeiro se todos os blocos do arquivo foram lidos; falso
+		 * se next parou antes do fim (bloco truncado ou corrompido).
+		 */
+		bool complete () const {
+			return m_offset == m_size;
+		}
+
+	private:
+		MappedFile m_file;
+		const char * m_data;
+		size_t m_size;
+		size_t m_offset;
+	};
+
+	/**
+	 * Lê fronteiras no formato texto do PISA: um vetor de objetivos por
+	 * linha, valores separados por espaço, fronteiras separadas por uma
+	 * linha em branco. Para cada fronteira, onFront (values, rows) é
+	 * chamada com os valores armazenados linha a linha.
+	 *
+	 * Se objectives for menor ou igual a zero, a quantidade de objetivos
+	 * é dada pela primeira linha. Linhas com quantidade diferente de
+	 * valores são ignoradas; uma linha com um valor inválido (por
+	 * exemplo "1-2" ou "0.5x") é tratada como uma linha em branco.
+	 *
+	 * @return quantidade de objetivos utilizada
+	 */
+	template <class Callback>
+	int parseText (const char * data, size_t size, int objectives, Callback onFront) {
+
+		std::vector<double> values;
+		std::vector<double> row;
+		int rows = 0;
+
+		const char * p = data;
+		const char * end = data + size;
+		while (p < end) {
+
+			const char * eol = (const char *) memchr (p, '\n', end - p);
+			if (eol == NULL) eol = end;
+
+			row.clear ();
+			const char * q = p;
+			while (q < eol) {
+				while (q < eol && (*q == ' ' || *q == '\t' || *q == '\r')) q++;
+				if (q == eol) break;
+
+				//cada valor termina em um separador ou no fim da linha
+				double value;
+				std::from_chars_result r = std::from_chars (q, eol, value);
+				if (r.ec != std::errc () || (r.ptr < eol && *r.ptr != ' ' && *r.ptr != '\t' && *r.ptr != '\r')) {
+					row.clear ();
+					break;
+				}
+				row.push_back (value);
+				q = r.ptr;
+			}
+
+			if (row.empty ()) {
+				if (eol < end && rows > 0) {
+					onFront (values, rows);
+					values.clear ();
+					rows = 0;
+				}
+			} else {
+				if (objectives <= 0) objectives = (int) row.size ();
+				if ((int) row.size () == objectives) {
+					values.insert (values.end (), row.begin (), row.end ());
+					rows++;
+				}
+			}
+
+			p = eol + 1;
+		}
+
+		if (rows > 0) onFront (values, rows);
+		return objectives;
+	}
+
+	/**
+	 * Retorna verdadeiro se o arquivo começa com o cabeçalho do formato
+	 * binário de fronteiras.
+	 */
+	inline bool isBinary (const std::string & file) {
+		FILE * f = fopen (file.c_str (), "rb");
+		if (f == NULL) return false;
+		uint32_t magic = 0;
+		bool binary = fread (&magic, sizeof (magic), 1, f) == 1 && magic == MAGIC;
+		fclose (f);
+		return binary;
+	}
+
+}
+
+#endif
@@ -0,0 +1,324 @@
+#ifndef _FRONT_MERGE_H_
+#define _FRONT_MERGE_H_
+
+#include <stdint.h>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <map>
+#include <iterator>
+#include <limits>
+#include <algorithm>
+
+#include "front_file.h"
+#include "mapped_file.h"
+#include "thread_pool.h"
+#include "dominance_sort.h"
+
+/**
+ * União das fronteiras de muitas execuções em uma fronteira de
+ * referência (veja tools/front_merge.cpp).
+ *
+ * Cada arquivo é lido fronteira a fronteira e reduzido ao seu conjunto
+ * não dominado local; os conjuntos locais são unidos por uma redução em
+ * árvore (pares de conjuntos vizinhos em cada rodada), em paralelo.
+ *
+ * O filtro não dominado ordena os vetores lexicograficamente e usa
+ * varreduras O(n log n) para dois e três objetivos; com mais objetivos
+ * utiliza DominanceSort. Vetores iguais aparecem uma única vez na saída,
+ * atribuídos ao arquivo de menor índice. Cada vetor guarda o índice do
+ * arquivo de origem, utilizado nas estatísticas de contribuição.
+ *
+ * @date 18/10/2026
+ */
+namespace FrontMerge {
+
+	/**
+	 * Conjunto de vetores (um por linha) e o arquivo de origem de cada um.
+	 */
+	struct Set {
+		std::vector<double> values;
+		std::vector<int> origin;
+
+		int rows () const { return (int) origin.size (); }
+
+		void clear () {
+			values.clear ();
+			origin.clear ();
+		}
+	};
+
+	/**
+	 * Mantém em set apenas os vetores não dominados (sense: 1 minimização,
+	 * -1 maximização). A ordem relativa dos vetores mantidos é preservada.
+	 * Vetores com algum objetivo NaN são descartados.
+	 */
+	inline void nondominated (Set & set, int objectives, const int * sense) {
+
+		const int M = objectives;
+		const int n = set.rows ();
+		if (n == 0) return;
+
+		//vetores convertidos para minimização
+		std::vector<double> key ((size_t) n * M);
+		std::vector<int> order;
+		for (int i=0; i < n; i++) {
+			bool valid = true;
+			for (int j=0; j < M; j++) {
+				double x = set.values[(size_t) i * M + j] * sense[j];
+				key[(size_t) i * M + j] = x;
+				valid = valid && x == x;
+			}
+			if (valid) order.push_back (i);
+		}
+		const int size = (int) order.size ();
+
+		//ordem lexicográfica; empates pela origem e pela posição
+		std::sort (order.begin (), order.end (), [&key, &set, M] (int a, int b) {
+			const double * x = &key[(size_t) a * M];
+			const double * y = &key[(size_t) b * M];
+			for (int j=0; j < M; j++) {
+				if (x[j] != y[j]) return x[j] < y[j];
+			}
+			if (set.origin[a] != set.origin[b]) return set.origin[a] < set.origin[b];
+			return a < b;
+		});
+
+		std::vector<char> keep (n, 0);
+
+		if (size == 0) {
+
+			//apenas vetores com NaN
+
+		} else if (M == 1) {
+
+			keep[order[0]] = 1;
+
+		} else if (M == 2) {
+
+			//um vetor é mantido se melhora o segundo objetivo de todos os anteriores
+			double best = std::numeric_limits<double>::infinity ();
+			for (int k=0; k < size; k++) {
+				double y = key[(size_t) order[k] * 2 + 1];
+				if (k == 0 || y < best) {
+					keep[order[k]] = 1;
+					best = y;
+				}
+			}
+
+		} else if (M == 3) {
+
+			//escada (f2 -> f3) dos vetores mantidos: f3 decresce com f2
+			std::map<double, double> stair;
+			for (int k=0; k < size; k++) {
+				const double * p = &key[(size_t) order[k] * 3];
+
+				std::map<double, double>::iterator it = stair.upper_bound (p[1]);
+				if (it != stair.begin () && std::prev (it)->second <= p[2]) continue;
+
+				keep[order[k]] = 1;
+
+				//remove os degraus que o novo vetor domina na projeção
+				it = stair.lower_bound (p[1]);
+				while (it != stair.end () && it->second >= p[2]) it = stair.erase (it);
+				stair[p[1]] = p[2];
+			}
+
+		} else {
+
+			//vetores iguais: apenas o primeiro da ordenação
+			std::vector<int> unique;
+			for (int k=0; k < size; k++) {
+				if (k > 0 && std::equal (&key[(size_t) order[k] * M], &key[(size_t) order[k] * M] + M,
+						&key[(size_t) order[k - 1] * M])) continue;
+				unique.push_back (order[k]);
+			}
+
+			std::vector<double> rows ((size_t) unique.size () * M);
+			for (unsigned u=0; u < unique.size (); u++) {
+				std::copy (&key[(size_t) unique[u] * M], &key[(size_t) unique[u] * M] + M, &rows[(size_t) u * M]);
+			}
+
+			std::vector<int> minimize (M, 1);
+			std::vector<char> front;
+			DominanceSort sort (M, &minimize[0]);
+			sort.nondominated (rows.data (), (int) unique.size (), front);
+			for (unsigned u=0; u < unique.size (); u++) keep[unique[u]] = front[u];
+		}
+
+		int kept = 0;
+		for (int i=0; i < n; i++) {
+			if (!keep[i]) continue;
+			if (kept != i) {
+				std::copy (&set.values[(size_t) i * M], &set.values[(size_t) i * M] + M,
+						&set.values[(size_t) kept * M]);
+				set.origin[kept] = set.origin[i];
+			}
+			kept++;
+		}
+		set.values.resize ((size_t) kept * M);
+		set.origin.resize (kept);
+	}
+
+	/**
+	 * Estatísticas da leitura de um arquivo.
+	 */
+	struct FileStats {
+		FileStats () : objectives (0), fronts (0), rows (0), local (0), contribution (0) {}
+
+		int objectives;
+		int fronts;
+		uint64_t rows;
+
+		//vetores não dominados do arquivo e vetores na referência
+		int local;
+		int contribution;
+	};
+
+	/**
+	 * Quantidade de valores da primeira linha não vazia de um arquivo
+	 * texto (zero se não há nenhuma).
+	 */
+	inline int columns (const char * data, size_t size) {
+		const char * p = data;
+		const char * end = data + size;
+		while (p < end) {
+			const char * eol = (const char *) memchr (p, '\n', end - p);
+			if (eol == NULL) eol = end;
+
+			int count = 0;
+			const char * q = p;
+			while (q < eol) {
+				while (q < eol && (*q == ' ' || *q == '\t' || *q == '\r')) q++;
+				if (q == eol) break;
+				while (q < eol && *q != ' ' && *q != '\t' && *q != '\r') q++;
+				count++;
+			}
+			if (count > 0) return count;
+			p = eol + 1;
+		}
+		return 0;
+	}
+
+	/**
+	 * Lê o arquivo file (texto do PISA ou binário) para set, mantendo
+	 * apenas os não dominados. O arquivo é processado fronteira a
+	 * fronteira e o filtro é aplicado sempre que os vetores pendentes
+	 * dobram o conjunto, de modo que a memória acompanha o conjunto não
+	 * dominado e não o arquivo inteiro.
+	 *
+	 * Com objectives menor ou igual a zero a quantidade de objetivos é a
+	 * do arquivo. sense possui um valor por objetivo (NULL: minimização).
+	 *
+	 * @return bool falso se o arquivo não pode ser lido, possui outra
+	 * quantidade de objetivos ou um bloco binário corrompido
+	 */
+	inline bool read (const std::string & file, int objectives, const int * sense,
+					int origin, Set & set, FileStats & stats)
+	{
+		set.clear ();
+		stats = FileStats ();
+
+		std::vector<int> minimize;
+		int limit = 1 << 16;
+
+		//acrescenta rows vetores e filtra quando há vetores pendentes demais
+		auto append = [&] (const double * values, int rows, int M) {
+			if (sense == NULL && (int) minimize.size () != M) minimize.assign (M, 1);
+			set.values.insert (set.values.end (), values, values + (size_t) rows * M);
+			set.origin.insert (set.origin.end (), rows, origin);
+			stats.rows += rows;
+			stats.fronts++;
+			if (set.rows () >= limit) {
+				nondominated (set, M, sense ? sense : &minimize[0]);
+				limit = std::max (limit, 2 * set.rows ());
+			}
+		};
+
+		int M = objectives;
+
+		if (FrontFile::isBinary (file)) {
+
+			FrontFile::Reader reader (file);
+			if (!reader.valid ()) return false;
+			if (M <= 0) M = reader.objectives ();
+			if (reader.objectives () != M) return false;
+
+			std::vector<double> rows;
+			FrontFile::Block block;
+			while (reader.next (block)) {
+				rows.resize ((size_t) block.rows * M);
+				for (int i=0; i < block.rows; i++) {
+					for (int j=0; j < M; j++) rows[(size_t) i * M + j] = block.value (i, j);
+				}
+				append (rows.data (), block.rows, M);
+			}
+			if (!reader.complete ()) return false;
+
+		} else {
+
+			MappedFile text (file);
+			if (text.data () == NULL) return false;
+
+			//parseText ignora linhas de outro tamanho: confere a primeira
+			int first = columns (text.data (), text.size ());
+			if (M > 0 && first > 0 && first != M) return false;
+
+			bool mismatch = false;
+			int found = FrontFile::parseText (text.data (), text.size (), M,
+				[&] (const std::vector<double> & values, int rows) {
+					int m = (int) (values.size () / rows);
+					if (M > 0 && m != M) {
+						mismatch = true;
+						return;
+					}
+					M = m;
+					append (values.data (), rows, M);
+				});
+			if (mismatch || M <= 0 || found != M) return false;
+		}
+
+		if (set.rows () > 0) nondominated (set, M, sense ? sense : &minimize[0]);
+
+		stats.objectives = M;
+		stats.local = set.rows ();
+		return true;
+	}
+
+	/**
+	 * Une os conjuntos de sets em sets[0] por uma redução em árvore: em
+	 * cada rodada o conjunto i recebe o conjunto i + step e é filtrado.
+	 * As uniões de uma rodada são independentes e executam em paralelo
+	 * no pool (NULL: serial). O resultado não depende da quantidade de
+	 * threads.
+	 */
+	inline void reduce (std::vector<Set> & sets, int objectives, const int * sense,
+						ThreadPool * pool = NULL)
+	{
+		const int n = (int) sets.size ();
+		const int M = objectives;
+
+		for (int step=1; step < n; step *= 2) {
+			for (int i=0; i + step < n; i += 2 * step) {
+
+				auto merge = [&sets, i, step, M, sense] {
+					Set & a = sets[i];
+					Set & b = sets[i + step];
+					a.values.insert (a.values.end (), b.values.begin (), b.values.end ());
+					a.origin.insert (a.origin.end (), b.origin.begin (), b.origin.end ());
+					std::vector<double> ().swap (b.values);
+					std::vector<int> ().swap (b.origin);
+					nondominated (a, M, sense);
+				};
+
+				if (pool != NULL) pool->submit (merge);
+				else merge ();
+			}
+			if (pool != NULL) pool->wait ();
+		}
+	}
+
+}
+
+#endif
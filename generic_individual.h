@@ -1,38 +1,59 @@
 #ifndef _IND_OBJ_
 #define _IND_OBJ_
 
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+
 #include "problem_info.h"
 
 /**
  * Esta estrutura é uma representação genérica
- * de um indivíduo. Nela é possível descrever a
- * representação de um indivíduo para um problema
- * específico ou importar uma implementação definida
- * em outra arquivo de cabeçalho.
+ * de um indivíduo. A representação específica do problema
+ * (genótipo) é definida pela política de problema utilizada
+ * pelos algoritmos e entra aqui como parâmetro de template.
+ *
+ * Desta forma um indivíduo custa apenas o seu genótipo e o
+ * vetor de objetivos. A criação e a avaliação dos indivíduos
+ * ficam a cargo da política de problema.
  *
+ * @see multicast_problem.h
  */
-typedef struct individual_t {
-	
+template <class Genotype>
+struct individual_t {
+
+	typedef Genotype genotype_type;
+
 	~individual_t () {
 		if (obj != NULL)
-			delete obj;
+			delete [] obj;
 	}
 
 	/**
-	 * Construtor padrão da Classe. Este construtor é utilizado
-	 * para definir objetos nulos. O parâmetro é definido apenas
-	 * para diferenciar do construtor que criar indivíduos para
-	 * problema definidos pelo usuário.
+	 * Construtor padrão da Classe. Este construtor define um
+	 * indivíduo nulo: objetivos iguais a zero e genótipo construído
+	 * pelo construtor padrão do tipo Genotype.
+	 *
+	 * Indivíduos do problema são criados pela política de problema
+	 * (Problem::create) sobre o genótipo de um indivíduo nulo.
 	 */
-	individual_t (bool);
+	individual_t ();
 
 	/**
-	 * Construtor utilizado para criar indivíduos através de um mecanismo
-	 * fornecido pelo usuário. O mecanismo é dependende do problema e deve
-	 * ser implementado no escopo do construtor ou incluido através de um
-	 * arquivo de cabeçalho.
+	 * Cópia, movimento e troca. O indivíduo é um tipo de valor: a cópia
+	 * duplica o vetor de objetivos, o movimento e a troca apenas trocam
+	 * ponteiros e não alocam memória.
+	 *
+	 * Um indivíduo movido fica sem vetor de objetivos (obj nulo) e deve
+	 * apenas receber outro indivíduo ou ser destruído.
 	 */
-	individual_t ();
+	individual_t (const individual_t &);
+	individual_t (individual_t &&) noexcept (std::is_nothrow_move_constructible<Genotype>::value);
+
+	individual_t & operator= (const individual_t &);
+	individual_t & operator= (individual_t &&) noexcept (std::is_nothrow_swappable<Genotype>::value);
+
+	void swap (individual_t &) noexcept (std::is_nothrow_swappable<Genotype>::value);
 
 	/**
 	 * Esta função é utilizada para associar o indivíduo passado como
@@ -41,13 +62,15 @@ typedef struct individual_t {
 	 * vetor que armazena a população.
 	 *
 	 * As informaçãos de individual_t são atribuídas ao objeto chamador.
+	 * Os algoritmos trocam indivíduos de posição trocando ponteiros;
+	 * assign é mantido para cópias explícitas.
 	 *
 	 * Retorna verdadeiro caso a atribuição seja realizada com exito.
 	 *
 	 * @param individual_
 	 * @return bool
 	 */
-	bool assign (individual_t *); 
+	bool assign (individual_t *);
 
 	/**
 	 * Usado para armazenar a posicao do indivíduo no vetor que
@@ -64,68 +87,141 @@ typedef struct individual_t {
 	 */
 	double crownding;
 
+	/**
+	 * Violação total das restrições do problema, definida pela
+	 * política de problema em evaluate. Zero indica um indivíduo
+	 * viável.
+	 */
+	double violation;
+
+	/**
+	 * Verdadeiro se os objetivos e a violação foram preditos por um
+	 * modelo substituto (ScreenedProblem) e não avaliados. Indivíduos
+	 * preditos participam da seleção, mas não dos limites dos objetivos
+	 * nem das saídas dos algoritmos (fronteiras gravadas, nondominated,
+	 * arquivo de ε-dominância e critério de parada).
+	 */
+	bool predicted;
 
 	double *obj;
 
 	/**
-	 * Objeto incluido na implementação do indivíduo genérico, este objeto
-	 * indica que o indivíduo a ser utilizada é referente ao Multicast
-	 * packing problem.
+	 * Genótipo do indivíduo. O tipo é fornecido pela política
+	 * de problema (Problem::genotype_type).
 	 */
-	MulticastIndividual mpp_ind;
-	
-		
-} GenericIndividual;
+	Genotype genotype;
 
-GenericIndividual::individual_t (bool val) {
+};
 
+/**
+ * Nome utilizado pelos algoritmos para o indivíduo genérico.
+ */
+template <class Genotype>
+using GenericIndividual = individual_t<Genotype>;
+
+template <class Genotype>
+individual_t<Genotype>::individual_t ()
+{
 	index = 0;
 	fitness = 0.0;
 	crownding = 0.0;
+	violation = 0.0;
+	predicted = false;
 	obj = new double[Info::OBJECTIVES];
 	for (int i=0; i < Info::OBJECTIVES; i++) {
 		obj[i] = 0;
 	}
+}
 
-	this->mpp_ind = MulticastIndividual (2,Info::mproblem->getNumberGroups(),Info::mproblem);
+template <class Genotype>
+individual_t<Genotype>::individual_t (const individual_t & ind)
+	: index (ind.index), fitness (ind.fitness), crownding (ind.crownding),
+	  violation (ind.violation), predicted (ind.predicted), obj (new double[Info::OBJECTIVES]),
+	  genotype (ind.genotype)
+{
+	if (ind.obj != NULL) std::copy (ind.obj, ind.obj + Info::OBJECTIVES, obj);
+	else std::fill (obj, obj + Info::OBJECTIVES, 0.0);
+}
 
+template <class Genotype>
+individual_t<Genotype>::individual_t (individual_t && ind)
+	noexcept (std::is_nothrow_move_constructible<Genotype>::value)
+	: index (ind.index), fitness (ind.fitness), crownding (ind.crownding),
+	  violation (ind.violation), predicted (ind.predicted), obj (ind.obj),
+	  genotype (std::move (ind.genotype))
+{
+	ind.obj = NULL;
 }
 
-GenericIndividual::individual_t () 
+template <class Genotype>
+individual_t<Genotype> & individual_t<Genotype>::operator= (const individual_t & ind)
 {
-	fitness = 0.0;
-	index = 0;
-	crownding = 0.0;
+	if (this == &ind) return *this;
 
-	/**
-	* Inicie a configuração de seu objeto aqui
-	*/
+	index = ind.index;
+	fitness = ind.fitness;
+	crownding = ind.crownding;
+	violation = ind.violation;
+	predicted = ind.predicted;
+	genotype = ind.genotype;
 
+	if (obj == NULL) obj = new double[Info::OBJECTIVES];
+	if (ind.obj != NULL) std::copy (ind.obj, ind.obj + Info::OBJECTIVES, obj);
 
-	//obj[0] = <seu individuo>.get Objective (i)
-	//obj[1] = <seu individuo>.get Objective (i)
+	return *this;
 }
 
-bool GenericIndividual::assign (individual_t * ind)
-{	
-	//verifica se o objeto já está no arquivo
-	if (ind->obj[0] == obj[0] &&
-		ind->obj[1] == obj[1] &&
-		ind->fitness == fitness) return false;
+template <class Genotype>
+individual_t<Genotype> & individual_t<Genotype>::operator= (individual_t && ind)
+	noexcept (std::is_nothrow_swappable<Genotype>::value)
+{
+	//o vetor de objetivos antigo fica com ind e é liberado por ele
+	swap (ind);
+	return *this;
+}
 
+template <class Genotype>
+void individual_t<Genotype>::swap (individual_t & ind)
+	noexcept (std::is_nothrow_swappable<Genotype>::value)
+{
+	using std::swap;
+	swap (index, ind.index);
+	swap (fitness, ind.fitness);
+	swap (crownding, ind.crownding);
+	swap (violation, ind.violation);
+	swap (predicted, ind.predicted);
+	swap (obj, ind.obj);
+	swap (genotype, ind.genotype);
+}
 
-	fitness = ind->fitness;
-	index = ind->index;
+template <class Genotype>
+void swap (individual_t<Genotype> & a, individual_t<Genotype> & b)
+	noexcept (noexcept (a.swap (b)))
+{
+	a.swap (b);
+}
 
-	/**
-	* ponha aqui alguma atribuição para o objeto que está
-	* recebendo o ind.
-	*/
+template <class Genotype>
+bool individual_t<Genotype>::assign (individual_t * ind)
+{
+	//verifica se o objeto já está no arquivo
+	if (ind->fitness == fitness) {
+		int equal = 0;
+		while (equal < Info::OBJECTIVES && ind->obj[equal] == obj[equal]) equal++;
+		if (equal == Info::OBJECTIVES) return false;
+	}
 
 
-	obj[0] = mpp_ind.getObjective (0);
-	obj[1] = mpp_ind.getObjective (1);
+	fitness = ind->fitness;
+	index = ind->index;
+	crownding = ind->crownding;
+	violation = ind->violation;
+	predicted = ind->predicted;
 
+	genotype = ind->genotype;
+	for (int i=0; i < Info::OBJECTIVES; i++) {
+		obj[i] = ind->obj[i];
+	}
 
 	return true;
 }
@@ -141,8 +237,9 @@ bool GenericIndividual::assign (individual_t * ind)
  * @param GenericIndividual
  * @return bool
  */
-bool compareByFitness(const GenericIndividual *ind1,
-					 const GenericIndividual *ind2)
+template <class Individual>
+bool compareByFitness(const Individual *ind1,
+					 const Individual *ind2)
 {
 	return ind1->fitness < ind2->fitness;
 }
@@ -157,7 +254,8 @@ bool compareByFitness(const GenericIndividual *ind1,
 struct compareByObjective {
 	compareByObjective(int __obj) :objective(__obj) {	}
 
-	bool operator() (GenericIndividual * ind1, GenericIndividual * ind2) {
+	template <class Individual>
+	bool operator() (const Individual * ind1, const Individual * ind2) const {
 		return ind1->obj[objective] < ind2->obj[objective];
 	}
 	int objective;
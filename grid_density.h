@@ -0,0 +1,178 @@
+#ifndef _GRID_DENSITY_H_
+#define _GRID_DENSITY_H_
+
+#include <stdint.h>
+#include <cmath>
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <unordered_map>
+
+#include "problem_info.h"
+
+/**
+ * Densidade por grade adaptativa (como no PESA-II e no ε-MOEA), uma
+ * alternativa às distâncias de todos os pares do Spea2 (DistanceEngine).
+ *
+ * A cada carga o intervalo de cada objetivo entre os vetores carregados
+ * é dividido em divisions faixas; cada vetor pertence a uma célula da
+ * grade (uma faixa por objetivo). As células ocupadas ficam em uma
+ * tabela hash (célula -> ocupação), de modo que a carga é O(size * M)
+ * esperado, independente da quantidade de células da grade.
+ *
+ *  - a densidade de um vetor é a ocupação da sua célula (occupancy);
+ *  - o truncamento retira vetores das células mais ocupadas: as células
+ *    ficam em listas por ocupação e cada remoção custa O(1) amortizado,
+ *    de modo que truncate é O(size) em vez de O(size^2).
+ *
+ * Os empates são resolvidos pela ordem de carga (sem sorteio): entre
+ * células igualmente ocupadas é escolhida a última célula a atingir a
+ * ocupação e, na célula, o último vetor carregado. Com divisions^M maior
+ * que 2^63 as células são identificadas por um hash dos índices, e
+ * células diferentes podem raramente ser tratadas como uma só.
+ *
+ * @date 18/10/2026
+ */
+class GridDensity {
+
+public:
+
+	/**
+	 * @param int faixas por objetivo
+	 */
+	GridDensity (int divisions = 16) : m_divisions (std::max (divisions, 1)), m_size (0), m_exact (true) {}
+
+	int divisions () const { return m_divisions; }
+
+	/**
+	 * Atribui uma célula a cada vetor de objetivos de population[0, size).
+	 */
+	template <class Individual>
+	void load (Individual ** population, int size) {
+
+		const int M = Info::OBJECTIVES;
+		m_size = size;
+
+		m_lower.assign (M, std::numeric_limits<double>::max ());
+		m_upper.assign (M, -std::numeric_limits<double>::max ());
+		for (int i=0; i < size; i++) {
+			for (int j=0; j < M; j++) {
+				m_lower[j] = std::min (m_lower[j], population[i]->obj[j]);
+				m_upper[j] = std::max (m_upper[j], population[i]->obj[j]);
+			}
+		}
+
+		//chave exata (base divisions) enquanto divisions^M cabe em 63 bits
+		m_exact = M * std::log2 ((double) m_divisions) < 63.0;
+
+		m_slots.clear ();
+		m_count.clear ();
+		m_head.clear ();
+		m_cell.resize (size);
+		m_next.resize (size);
+
+		for (int i=0; i < size; i++) {
+			std::pair<std::unordered_map<uint64_t, int>::iterator, bool> slot =
+					m_slots.emplace (key (population[i]->obj), (int) m_count.size ());
+			if (slot.second) {
+				m_count.push_back (0);
+				m_head.push_back (-1);
+			}
+
+			int c = slot.first->second;
+			m_cell[i] = c;
+			m_next[i] = m_head[c];
+			m_head[c] = i;
+			m_count[c]++;
+		}
+	}
+
+	/**
+	 * Quantidade de vetores na célula do vetor i (incluindo o próprio).
+	 */
+	int occupancy (int i) const { return m_count[m_cell[i]]; }
+
+	/**
+	 * Quantidade de células ocupadas.
+	 */
+	int cells () const { return (int) m_count.size (); }
+
+	/**
+	 * Escolhe remove vetores a retirar, um de cada vez da célula mais
+	 * ocupada no momento, e os marca em removed (size posições). Altera
+	 * as ocupações: occupancy passa a contar apenas os vetores mantidos.
+	 */
+	void truncate (int remove, std::vector<char> & removed) {
+
+		removed.assign (m_size, 0);
+		remove = std::min (remove, m_size);
+
+		int top = 0;
+		for (unsigned c=0; c < m_count.size (); c++) top = std::max (top, m_count[c]);
+
+		if ((int) m_buckets.size () < top + 1) m_buckets.resize (top + 1);
+		for (int k=0; k <= top; k++) m_buckets[k].clear ();
+		for (unsigned c=0; c < m_count.size (); c++) m_buckets[m_count[c]].push_back (c);
+
+		for (; remove > 0; remove--) {
+			while (m_buckets[top].empty ()) top--;
+
+			int c = m_buckets[top].back ();
+			m_buckets[top].pop_back ();
+
+			int i = m_head[c];
+			m_head[c] = m_next[i];
+			removed[i] = 1;
+
+			if (--m_count[c] > 0) m_buckets[m_count[c]].push_back (c);
+		}
+	}
+
+private:
+
+	/**
+	 * Célula do vetor obj nos limites da última carga.
+	 */
+	uint64_t key (const double * obj) const {
+
+		uint64_t k = m_exact ? 0 : 0x9e3779b97f4a7c15ULL;
+		for (unsigned j=0; j < m_lower.size (); j++) {
+
+			double range = m_upper[j] - m_lower[j];
+			double x = range > 0.0 ? (obj[j] - m_lower[j]) / range * m_divisions : 0.0;
+
+			//NaN e valores fora dos limites ficam nas faixas extremas
+			int index = x >= 0.0 ? (int) std::min (x, (double) (m_divisions - 1)) : 0;
+
+			if (m_exact) {
+				k = k * m_divisions + index;
+			} else {
+				k ^= (uint64_t) index;
+				k *= 0xff51afd7ed558ccdULL;
+				k ^= k >> 32;
+			}
+		}
+		return k;
+	}
+
+	int m_divisions;
+	int m_size;
+	bool m_exact;
+
+	std::vector<double> m_lower;
+	std::vector<double> m_upper;
+
+	//célula -> slot; por slot: ocupação e primeiro vetor da lista
+	std::unordered_map<uint64_t, int> m_slots;
+	std::vector<int> m_count;
+	std::vector<int> m_head;
+
+	//por vetor: slot da célula e próximo vetor da mesma célula
+	std::vector<int> m_cell;
+	std::vector<int> m_next;
+
+	//slots por ocupação, utilizados no truncamento
+	std::vector<std::vector<int> > m_buckets;
+};
+
+#endif
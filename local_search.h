@@ -0,0 +1,347 @@
+#ifndef _LOCAL_SEARCH_H_
+#define _LOCAL_SEARCH_H_
+
+#include <stdint.h>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <unordered_set>
+
+#include "problem_info.h"
+#include "generic_individual.h"
+#include "multiobjective.h"
+#include "random.h"
+#include "lock_free_queue.h"
+#include "variation.h"
+
+/**
+ * Estágio de refinamento memético: busca local de Pareto executada em
+ * threads auxiliares, em paralelo ao laço principal do Nsga2 e do Spea2.
+ *
+ * O algoritmo envia as soluções não dominadas da geração (rank 0 no
+ * Nsga2, arquivo no Spea2) para as threads de busca local e, na geração
+ * seguinte, recebe as soluções melhoradas, que substituem parte da
+ * prole e disputam a seleção com ela:
+ *
+ *		LocalSearchStage<Zdt1> memetic (problem, 2);
+ *		nsga2.setLocalSearch (&memetic);
+ *		nsga2.run ();
+ *		memetic.printStatistics ();
+ *
+ * Cada thread possui uma fila de entrada e uma de saída (SpscQueue), de
+ * modo que a comunicação com o algoritmo não utiliza travas: o algoritmo
+ * apenas insere e retira soluções das filas e nunca espera pelas threads.
+ * Sementes que não cabem na fila são descartadas.
+ *
+ * A partir de cada semente a thread executa uma busca local de Pareto:
+ * mantém um arquivo de soluções mutuamente não dominadas (dominância com
+ * restrições, MultiObjective::dominate) e, enquanto houver orçamento,
+ * avalia em lote moves vizinhos da primeira solução ainda não explorada.
+ * Um vizinho entra no arquivo se nenhuma solução do arquivo o domina e
+ * remove as que ele domina. As soluções novas do arquivo final são
+ * devolvidas ao algoritmo. Os vizinhos são gerados por Variation::neighbour
+ * (Problem::neighbour ou, na falta dela, Problem::mutation).
+ *
+ * Cada thread avalia os vizinhos com a sua própria cópia da política de
+ * problema e possui o seu gerador. Como em Experiment, as cópias devem
+ * poder avaliar soluções ao mesmo tempo que a política do algoritmo.
+ * As threads utilizam a configuração dos objetivos (Info) da thread que
+ * criou o estágio.
+ *
+ * As soluções recebidas dependem do tempo relativo entre as threads:
+ * uma execução com busca local não é reproduzível pela semente.
+ *
+ * @date 18/10/2026
+ */
+template <class Problem>
+class LocalSearchStage {
+
+public:
+	typedef typename Problem::genotype_type genotype_type;
+	typedef GenericIndividual<genotype_type> Individual;
+
+	/**
+	 * @param Problem política de problema (copiada para cada thread)
+	 * @param int quantidade de threads de busca local
+	 * @param int vizinhos avaliados por passo da busca
+	 * @param int avaliações por semente
+	 * @param double fração da prole que pode ser substituída por geração
+	 * @param uint64_t semente dos geradores das threads
+	 */
+	LocalSearchStage (const Problem & problem, int threads = 1, int moves = 8,
+			int budget = 64, double share = 0.25, uint64_t seed = 1)
+		: m_moves (std::max (moves, 1)), m_budget (std::max (budget, 1)), m_share (share),
+		  m_objectives (Info::OBJECTIVES),
+		  m_sense (Info::objconf, Info::objconf + (Info::objconf ? Info::OBJECTIVES : 0)),
+		  m_epsilon (Info::epsilon, Info::epsilon + (Info::epsilon ? Info::OBJECTIVES : 0)),
+		  m_next (0), m_running (true), m_submitted (0), m_searched (0),
+		  m_evaluations (0), m_improved (0), m_received (0)
+	{
+		if (threads < 1) threads = 1;
+
+		Random random (seed);
+		for (int i=0; i < threads; i++) {
+			m_workers.push_back (new Worker (problem, random.next (), m_moves));
+		}
+		for (int i=0; i < threads; i++) {
+			m_workers[i]->thread = std::thread (&LocalSearchStage::loop, this, m_workers[i]);
+		}
+	}
+
+	/**
+	 * Interrompe as buscas em andamento e encerra as threads.
+	 */
+	~LocalSearchStage () {
+		m_running.store (false, std::memory_order_release);
+		for (unsigned i=0; i < m_workers.size (); i++) {
+			m_workers[i]->thread.join ();
+			delete m_workers[i];
+		}
+	}
+
+	/**
+	 * Envia uma cópia de individual como semente de busca local. Uma
+	 * solução com o mesmo vetor de objetivos de uma semente enviada
+	 * recentemente não é enviada de novo.
+	 *
+	 * @return bool falso se a solução foi descartada
+	 */
+	bool submit (const Individual * individual) {
+
+		uint64_t key = signature (individual->obj);
+		if (m_seen.count (key)) return false;
+		if (m_seen.size () >= 4096) m_seen.clear ();
+
+		m_seed.genotype = individual->genotype;
+		m_seed.obj.assign (individual->obj, individual->obj + Info::OBJECTIVES);
+		m_seed.violation = individual->violation;
+
+		//distribuição circular, tentando as demais threads se a fila estiver cheia
+		for (unsigned t=0; t < m_workers.size (); t++) {
+			Worker * worker = m_workers[m_next];
+			m_next = (m_next + 1) % m_workers.size ();
+			if (worker->inbox.push (m_seed)) {
+				m_seen.insert (key);
+				m_submitted++;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/**
+	 * Retira das filas de saída até max soluções melhoradas.
+	 *
+	 * @return int quantidade de soluções disponíveis para assign
+	 */
+	int collect (int max) {
+
+		m_ready.resize (std::max (max, 0));
+
+		int count = 0;
+		bool found = true;
+		while (count < max && found) {
+			found = false;
+			for (unsigned t=0; t < m_workers.size () && count < max; t++) {
+				if (m_workers[t]->outbox.pop (m_ready[count])) {
+					count++;
+					found = true;
+				}
+			}
+		}
+		m_received += count;
+		return count;
+	}
+
+	/**
+	 * Copia a solução i retirada por collect para target.
+	 */
+	void assign (int i, Individual * target) const {
+		const Solution & solution = m_ready[i];
+		target->genotype = solution.genotype;
+		target->violation = solution.violation;
+		target->predicted = false;
+		std::copy (solution.obj.begin (), solution.obj.end (), target->obj);
+	}
+
+	/**
+	 * Quantidade de indivíduos de uma prole de size indivíduos que pode
+	 * ser substituída por soluções da busca local em uma geração.
+	 */
+	int limit (int size) const {
+		return std::min (size, (int) (m_share * size + 0.5));
+	}
+
+	uint64_t evaluations () const { return m_evaluations.load (); }
+	uint64_t improved () const { return m_improved.load (); }
+
+	void printStatistics () {
+		printf ("Local search: %llu seeds %llu searched %llu evaluations %llu improved %llu received\n",
+				(unsigned long long) m_submitted, (unsigned long long) m_searched.load (),
+				(unsigned long long) m_evaluations.load (), (unsigned long long) m_improved.load (),
+				(unsigned long long) m_received);
+	}
+
+private:
+
+	static uint64_t signature (const double * obj) {
+		uint64_t h = 0x9e3779b97f4a7c15ULL;
+		for (int j=0; j < Info::OBJECTIVES; j++) {
+			double value = obj[j] == 0.0 ? 0.0 : obj[j];
+			uint64_t bits;
+			memcpy (&bits, &value, sizeof (double));
+			h ^= bits;
+			h *= 0xff51afd7ed558ccdULL;
+			h ^= h >> 32;
+		}
+		return h;
+	}
+
+	struct Solution {
+		Solution () : violation (0.0), explored (false), fresh (false) {}
+
+		genotype_type genotype;
+		std::vector<double> obj;
+		double violation;
+
+		//passos já feitos a partir da solução; solução gerada pela busca
+		bool explored;
+		bool fresh;
+	};
+
+	struct Worker {
+		Worker (const Problem & p, uint64_t seed, int moves)
+			: problem (p), random (seed), candidates (moves) {
+			for (int i=0; i < moves; i++) candidates[i] = new Individual;
+		}
+
+		~Worker () {
+			for (unsigned i=0; i < candidates.size (); i++) delete candidates[i];
+		}
+
+		Problem problem;
+		Random random;
+		SpscQueue<Solution> inbox;
+		SpscQueue<Solution> outbox;
+		std::thread thread;
+
+		std::vector<Individual *> candidates;
+		std::vector<Solution> archive;
+	};
+
+	void loop (Worker * worker) {
+
+		Info::Scope scope (m_objectives, m_sense.empty () ? NULL : &m_sense[0],
+				m_epsilon.empty () ? NULL : &m_epsilon[0]);
+
+		Solution seed;
+		while (m_running.load (std::memory_order_acquire)) {
+			if (!worker->inbox.pop (seed)) {
+				std::this_thread::sleep_for (std::chrono::microseconds (200));
+				continue;
+			}
+			search (*worker, seed);
+		}
+	}
+
+	/**
+	 * Busca local de Pareto a partir de seed.
+	 */
+	void search (Worker & worker, const Solution & seed) {
+
+		std::vector<Solution> & archive = worker.archive;
+		archive.clear ();
+		archive.push_back (seed);
+		archive[0].explored = false;
+		archive[0].fresh = false;
+
+		int evaluations = 0;
+		while (evaluations < m_budget && m_running.load (std::memory_order_relaxed)) {
+
+			unsigned current = 0;
+			while (current < archive.size () && archive[current].explored) current++;
+			if (current == archive.size ()) break;
+			archive[current].explored = true;
+
+			//os vizinhos são gerados antes de alterar o arquivo
+			for (int c=0; c < m_moves; c++) {
+				Variation::neighbour (worker.problem, archive[current].genotype,
+						worker.candidates[c]->genotype, worker.random);
+			}
+			worker.problem.evaluate (&worker.candidates[0], m_moves);
+			evaluations += m_moves;
+
+			for (int c=0; c < m_moves; c++) accept (archive, worker.candidates[c]);
+		}
+
+		m_searched++;
+		m_evaluations += evaluations;
+
+		for (unsigned i=0; i < archive.size (); i++) {
+			if (archive[i].fresh && worker.outbox.push (archive[i])) m_improved++;
+		}
+	}
+
+	/**
+	 * Aceitação de Pareto: candidate entra no arquivo se nenhuma solução
+	 * do arquivo o domina (vetores iguais são recusados) e remove as
+	 * soluções que domina. Candidatos com objetivos preditos
+	 * (ScreenedProblem) são recusados.
+	 */
+	void accept (std::vector<Solution> & archive, Individual * candidate) {
+
+		if (candidate->predicted) return;
+
+		for (unsigned i=0; i < archive.size (); i++) {
+			if (MultiObjective::dominate (&archive[i].obj[0], candidate->obj,
+					archive[i].violation, candidate->violation)) return;
+		}
+
+		unsigned kept = 0;
+		for (unsigned i=0; i < archive.size (); i++) {
+			if (!MultiObjective::dominate (candidate->obj, &archive[i].obj[0],
+					candidate->violation, archive[i].violation)) {
+				if (kept != i) std::swap (archive[kept], archive[i]);
+				kept++;
+			}
+		}
+		archive.resize (kept);
+
+		archive.push_back (Solution ());
+		Solution & solution = archive.back ();
+		solution.genotype = candidate->genotype;
+		solution.obj.assign (candidate->obj, candidate->obj + Info::OBJECTIVES);
+		solution.violation = candidate->violation;
+		solution.fresh = true;
+	}
+
+	int m_moves;
+	int m_budget;
+	double m_share;
+
+	//configuração dos objetivos instalada nas threads
+	int m_objectives;
+	std::vector<int> m_sense;
+	std::vector<double> m_epsilon;
+
+	std::vector<Worker *> m_workers;
+	unsigned m_next;
+	std::atomic<bool> m_running;
+
+	//usados apenas pela thread do algoritmo
+	Solution m_seed;
+	std::vector<Solution> m_ready;
+	std::unordered_set<uint64_t> m_seen;
+	uint64_t m_submitted;
+
+	std::atomic<uint64_t> m_searched;
+	std::atomic<uint64_t> m_evaluations;
+	std::atomic<uint64_t> m_improved;
+	uint64_t m_received;
+};
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef _LOCK_FREE_QUEUE_H_
+#define _LOCK_FREE_QUEUE_H_
+
+#include <atomic>
+#include <vector>
+#include <cstddef>
+
+/**
+ * Fila circular sem bloqueio (lock-free) para um produtor e um
+ * consumidor (SPSC). Utilizada para passar dados da thread do
+ * algoritmo para threads auxiliares (escrita de resultados, por
+ * exemplo) sem mutex no caminho crítico.
+ *
+ * A capacidade é arredondada para a próxima potência de dois.
+ * push e pop não bloqueiam: retornam falso se a fila estiver cheia
+ * ou vazia, respectivamente.
+ *
+ * @date 18/10/2026
+ */
+template <class T>
+class SpscQueue {
+
+public:
+	SpscQueue (size_t capacity = 64) : m_head (0), m_tail (0) {
+		size_t size = 2;
+		while (size < capacity) size <<= 1;
+		m_buffer.resize (size);
+		m_mask = size - 1;
+	}
+
+	/**
+	 * Insere um elemento. Deve ser chamado apenas pelo produtor.
+	 * @return bool falso se a fila estiver cheia
+	 */
+	bool push (const T & value) {
+		const size_t tail = m_tail.load (std::memory_order_relaxed);
+		if (tail - m_head.load (std::memory_order_acquire) > m_mask) return false;
+
+		m_buffer[tail & m_mask] = value;
+		m_tail.store (tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	/**
+	 * Remove um elemento. Deve ser chamado apenas pelo consumidor.
+	 * @return bool falso se a fila estiver vazia
+	 */
+	bool pop (T & value) {
+		const size_t head = m_head.load (std::memory_order_relaxed);
+		if (head == m_tail.load (std::memory_order_acquire)) return false;
+
+		value = m_buffer[head & m_mask];
+		m_head.store (head + 1, std::memory_order_release);
+		return true;
+	}
+
+	bool empty () const {
+		return m_head.load (std::memory_order_acquire) ==
+				m_tail.load (std::memory_order_acquire);
+	}
+
+private:
+	std::vector<T> m_buffer;
+	size_t m_mask;
+
+	//produtor e consumidor em linhas de cache diferentes
+	alignas(64) std::atomic<size_t> m_head;
+	alignas(64) std::atomic<size_t> m_tail;
+};
+
+#endif
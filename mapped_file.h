@@ -0,0 +1,59 @@
+#ifndef _MAPPED_FILE_H_
+#define _MAPPED_FILE_H_
+
+#include <string>
+#include <cstddef>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/**
+ * Arquivo mapeado em memória somente para leitura.
+ * Utilizado pelos leitores dos formatos binários (checkpoint e
+ * fronteiras) para acessar os dados sem cópia.
+ *
+ * Se o arquivo não existe ou não pode ser mapeado, data() retorna
+ * NULL e size() retorna 0.
+ */
+class MappedFile {
+
+public:
+	MappedFile (const std::string & file) : m_data (NULL), m_size (0) {
+
+		int fd = open (file.c_str (), O_RDONLY);
+		if (fd < 0) return;
+
+		struct stat st;
+		if (fstat (fd, &st) == 0 && st.st_size > 0) {
+			void * data = mmap (NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (data != MAP_FAILED) {
+				m_data = (const char *) data;
+				m_size = st.st_size;
+			}
+		}
+		close (fd);
+	}
+
+	~MappedFile () {
+		if (m_data != NULL) munmap ((void *) m_data, m_size);
+	}
+
+	const char * data () const {
+		return m_data;
+	}
+
+	size_t size () const {
+		return m_size;
+	}
+
+private:
+	MappedFile (const MappedFile &);
+	MappedFile & operator= (const MappedFile &);
+
+	const char * m_data;
+	size_t m_size;
+};
+
+#endif
@@ -0,0 +1,134 @@
+#ifndef _MULTICAST_PROBLEM_H_
+#define _MULTICAST_PROBLEM_H_
+
+#include <stdint.h>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "generic_individual.h"
+#include "random.h"
+
+//ADICICIONE OS CABEÇALHOS DO SEU PROBLEMA
+
+/*
+#include "../network/reader.h"
+#include "../network/group.h"
+#include "../network/network.h"
+#include "../individual/multicastindividual.h"
+#include "../individual/mpackingoperator.h"
+#include "../algorithms/util.h"
+*/
+
+/**
+ * Política de problema para o Multicast Packing Problem.
+ *
+ * Os algoritmos (Nsga2, Spea2) são parametrizados por uma
+ * política de problema. Esta classe é o exemplo utilizado no
+ * LAE e serve de modelo para outros problemas. Uma política
+ * de problema deve fornecer:
+ *
+ *  - genotype_type: tipo que representa a solução do problema.
+ *    Deve possuir construtor padrão barato (indivíduo nulo) e
+ *    operador de atribuição;
+ *  - create (genotype_type &, Random &): constrói uma solução inicial;
+ *  - crossover (const genotype_type &, const genotype_type &,
+ *    genotype_type &, Random &): gera um filho a partir de dois pais;
+ *  - mutation (genotype_type &, Random &): aplica mutação ao genótipo;
+ *  - evaluate (GenericIndividual<genotype_type> **, int): avalia
+ *    um lote de indivíduos, preenchendo o vetor obj de cada um e,
+ *    em problemas com restrições, a violação total (violation);
+ *  - write (const genotype_type &, std::vector<char> &) e
+ *    read (const char *, size_t, genotype_type &): serializam o
+ *    genótipo para os checkpoints;
+ *  - hash (const genotype_type &): hash de 64 bits do genótipo,
+ *    utilizado pelo cache de avaliações (CachedProblem).
+ *
+ * Opcionalmente a política pode fornecer recombine, que recebe o
+ * lote inteiro de pais de uma geração no lugar de crossover e
+ * mutation (veja variation.h), e neighbour, que gera os vizinhos
+ * de uma solução na busca local (veja local_search.h).
+ *
+ * A avaliação é feita em lote: os algoritmos acumulam todos os
+ * indivíduos de uma geração e invocam evaluate uma única vez.
+ *
+ * Os operadores devem sortear números apenas através do gerador
+ * Random recebido, que pertence à execução. Assim a execução é
+ * reproduzível e pode ser retomada de um checkpoint.
+ *
+ * A política guarda a instância que resolve (por padrão a carregada
+ * por ProblemInfo em Info::mproblem). Políticas com instâncias
+ * diferentes podem ser executadas ao mesmo tempo no mesmo processo,
+ * cada uma com a sua RunConfig.
+ *
+ * @see GenericIndividual
+ */
+struct MulticastProblem {
+
+	typedef MulticastIndividual genotype_type;
+	typedef GenericIndividual<genotype_type> Individual;
+
+	MulticastProblem (MulticastPacking * instance = Info::mproblem) : m_instance (instance) {}
+
+	void create (genotype_type & genotype, Random & random) {
+
+		genotype = MulticastIndividual (2,m_instance->getNumberGroups(),
+										m_instance);
+
+		/**
+		* Inicie a configuração de seu objeto aqui
+		*/
+	}
+
+	void crossover (const genotype_type & p1, const genotype_type & p2,
+					genotype_type & child, Random & random) {
+
+		//ponha aqui o seu operador de cruzamento
+		child = p1;
+	}
+
+	void mutation (genotype_type & genotype, Random & random) {
+
+		//ponha aqui o seu operador de mutação
+	}
+
+	void evaluate (Individual ** individuals, int size) {
+
+		for (int i=0; i < size; i++) {
+			for (int j=0; j < Info::OBJECTIVES; j++) {
+				individuals[i]->obj[j] = individuals[i]->genotype.getObjective (j);
+			}
+
+			//violação das restrições de capacidade (0 se viável)
+			individuals[i]->violation = 0.0;
+		}
+	}
+
+	uint64_t hash (const genotype_type & genotype) {
+
+		//ponha aqui o hash do seu indivíduo, por exemplo
+		//EvaluationCache::hashBytes sobre a sua representação.
+		//Um hash constante faria o cache (CachedProblem) devolver
+		//a mesma avaliação a todos os indivíduos
+		fprintf (stderr, "MulticastProblem::hash não implementado\n");
+		abort ();
+	}
+
+	void write (const genotype_type & genotype, std::vector<char> & buffer) {
+
+		//ponha aqui a serialização do seu indivíduo (anexar em buffer)
+	}
+
+	void read (const char * data, size_t size, genotype_type & genotype) {
+
+		genotype = MulticastIndividual (2,m_instance->getNumberGroups(),
+										m_instance);
+
+		//ponha aqui a leitura do seu indivíduo a partir de data
+	}
+
+	MulticastPacking * m_instance;
+
+};
+
+#endif
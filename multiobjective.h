@@ -7,8 +7,14 @@
 #include <iostream>
 
 #include <sstream>
+#include <string>
+#include <vector>
 
 #include "problem_info.h"
+#include "front_file.h"
+#include "mapped_file.h"
+#include "thread_pool.h"
+#include "dominance_sort.h"
 
 namespace MultiObjective {
 
@@ -22,13 +28,44 @@ namespace MultiObjective {
 	 * não domina.
 	 *
 	 * Se em todos os objetivos a propriedade acima não é encontrada
-	 * então o vetor2 não é dominado pelo vetor1.
+	 * então o vetor2 é dominado pelo vetor1.
 	 *
+	 * A dominância é fraca: dois vetores iguais dominam um ao outro.
+	 * Um objetivo NaN não é menor nem maior que nenhum valor, de modo
+	 * que um vetor com NaN não domina e não é dominado (como em
+	 * DominanceSort).
+	 *
+	 * @see tools/engine_check.cpp
 	 * @date 11/10/2012
 	 * @author Romerito Campos
 	 */
 	int dominate (double *vetor1, double *vetor2);
 
+	/**
+	 * Dominância com restrições de Deb. violacao1 e violacao2 são as
+	 * violações totais das restrições dos dois vetores (zero indica
+	 * viável). O vetor1 domina o vetor2 se:
+	 *
+	 *  - o vetor1 é viável e o vetor2 é inviável; ou
+	 *  - ambos são inviáveis e violacao1 é menor que violacao2; ou
+	 *  - ambos são viáveis e dominate (vetor1, vetor2).
+	 *
+	 * @see Constraints
+	 */
+	int dominate (double *vetor1, double *vetor2, double violacao1, double violacao2);
+
+	/**
+	 * Tolerância absoluta utilizada por equals na comparação de cada
+	 * objetivo.
+	 */
+	const double TOLERANCE = 1e-9;
+
+	/**
+	 * Verifica se os dois vetores possuem o mesmo valor em todos
+	 * os objetivos (diferença menor que TOLERANCE).
+	 */
+	bool equals (double *vetor1, double *vetor2);
+
 	/**
 	 * Está função calcula a distância euclidiana entre dois
 	 * pontos no espaço n-dimensinal.
@@ -38,28 +75,38 @@ namespace MultiObjective {
 	 */
 	double distanceCalc (double *, double *);
 
-	/* Recebe um arquivo de texto filtra os não dominados*/
-	void filter (std::string file_name);
+	/**
+	 * Recebe um arquivo de fronteiras e imprime os não dominados.
+	 * O arquivo pode estar no formato texto do PISA ou no formato
+	 * binário colunar (ver front_file.h); o formato é detectado
+	 * pelo cabeçalho do arquivo.
+	 *
+	 * Com pool a verificação de dominância é dividida entre as
+	 * threads (ver DominanceSort).
+	 */
+	void filter (std::string file_name, ThreadPool * pool = NULL);
+
+	/**
+	 * Lê todos os vetores de objetivos de um arquivo de fronteiras
+	 * (texto ou binário) para values, linha a linha.
+	 * Retorna a quantidade de vetores lidos ou -1 se o arquivo não
+	 * possui Info::OBJECTIVES objetivos ou possui um bloco binário
+	 * corrompido.
+	 */
+	int readFronts (const std::string & file_name, std::vector<double> & values);
 
 	enum {DOMINATED = 1, NONDOMINTED = 0};
 	
 }
-#endif 
 
 namespace MultiObjective {
 	
-	int dominate (double * vetor1, double * vetor2) {
+	inline int dominate (double * vetor1, double * vetor2) {
 		
-		
-		int equal = 0;
 		for (int i=0; i < Info::OBJECTIVES; i++) {
 			
-			if (rca::compareDouble (vetor1[i],vetor2[i])) {
-				equal++;
-			}
-			
-			//se algum vetor1[i] é maior que vetor2[i] então vetor1 não domina vetor2
-			if (vetor1[i]*Info::objconf[i] > vetor2[i]*Info::objconf[i]) {
+			//se algum vetor1[i] não é menor ou igual a vetor2[i] então vetor1 não domina vetor2
+			if (!(vetor1[i]*Info::objconf[i] <= vetor2[i]*Info::objconf[i])) {
 				return NONDOMINTED;
 			}
 		}
@@ -68,7 +115,28 @@ namespace MultiObjective {
 		return DOMINATED;
 	}
 	
-	double distanceCalc (double * vector1, double * vector2) {
+	inline int dominate (double * vetor1, double * vetor2, double violacao1, double violacao2) {
+
+		if (violacao1 > 0.0 || violacao2 > 0.0) {
+			if (violacao2 <= 0.0) return NONDOMINTED;
+			if (violacao1 <= 0.0) return DOMINATED;
+			return violacao1 < violacao2 ? DOMINATED : NONDOMINTED;
+		}
+
+		return dominate (vetor1, vetor2);
+	}
+
+	inline bool equals (double * vetor1, double * vetor2) {
+
+		for (int i=0; i < Info::OBJECTIVES; i++) {
+			if (!(std::fabs (vetor1[i] - vetor2[i]) < TOLERANCE)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	inline double distanceCalc (double * vector1, double * vector2) {
 		double sum = 0.0;
 		for (int i = 0; i < Info::OBJECTIVES; i++) {
 			sum += pow(vector1[i] - vector2[i], 2.0);
@@ -77,93 +145,61 @@ namespace MultiObjective {
 		return sqrt (sum);
 	}
 
-	void filter(std::string file_name) {
+	inline int readFronts (const std::string & file_name, std::vector<double> & values) {
 
-		std::ifstream file (file_name.c_str(), std::ifstream::in);
+		const int M = Info::OBJECTIVES;
+		values.clear ();
 
-		int size = 0;
-		char l;
-		string ss;
-		double value = 0.0;
+		if (FrontFile::isBinary (file_name)) {
 
-		double **individuals;
-
-		while ( !file.get(l).eof() ) {
-
-			if (l != ' ' && l != '\n') {
-				ss.push_back(l);
-			}
+			FrontFile::Reader reader (file_name);
+			if (!reader.valid () || reader.objectives () != M) return -1;
 
-			if (l == ' ') {
-				ss.clear();
+			FrontFile::Block block;
+			while (reader.next (block)) {
+				for (int i=0; i < block.rows; ++i) {
+					for (int j=0; j < M; ++j) {
+						values.push_back (block.value (i, j));
+					}
+				}
 			}
+			if (!reader.complete ()) return -1;
 
-			if ( l == '\n') {
-				ss.clear();
-				size++;
-			}
-		}
+		} else {
 
-		individuals = new double*[size];
-		for (int i=0; i < size; ++i) {
-			individuals[i] = new double[Info::OBJECTIVES];
+			MappedFile file (file_name);
+			FrontFile::parseText (file.data (), file.size (), M,
+				[&values](const std::vector<double> & front, int) {
+					values.insert (values.end (), front.begin (), front.end ());
+				});
 		}
 
-		file.close();
-
-		file.open(file_name.c_str(), std::ifstream::in);
-
-		size = 0;
-		int obj = 0;
-		while ( !file.get(l).eof() ) {
-
-			if (l != ' ' && l != '\n') {
-				ss.push_back(l);
-			}
+		return (int) (values.size () / M);
+	}
 
-			if (l == ' ') {
+	inline void filter(std::string file_name, ThreadPool * pool) {
 
-				value = atof(ss.c_str());
-				individuals[size][obj] = value;
-				obj++;
-				ss.clear();
-			}
+		std::vector<double> individuals;
+		int size = readFronts (file_name, individuals);
+		if (size < 0) return;
 
-			if ( l == '\n') {
-				value = atof(ss.c_str());
-				individuals[size][obj] = value;
-				ss.clear();
-
-				size++;
-				obj = 0;
-			}
-		}
+		const int M = Info::OBJECTIVES;
 
+		std::vector<char> nondominated;
+		DominanceSort sort (M, Info::objconf, pool);
+		sort.nondominated (individuals.data (), size, nondominated);
 
 		for (int i=0; i < size; ++i) {
 
-			int count = 0;
-			int j = 0;
-			for (; j < size; ++j) {
-
-				if (j==i) continue;
-
-				if (dominate(individuals[j],individuals[i])) {
-					count++;
+			if (nondominated[i]) {
+				for (int k=0; k < M; ++k) {
+					std::cout << individuals[i * M + k] << (k + 1 < M ? " " : "\n");
 				}
 			}
 
-			if (count == 0) {
-				cout << individuals[i][0] << " " << individuals[i][1] << endl;
-			}
-
 		}
-
-		//freeing memory
-		for (int i=0; i < size; ++i) {
-			delete individuals[i];
-		}
-		delete [] individuals;
 	}
 
 }
+
+#endif
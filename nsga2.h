@@ -4,8 +4,24 @@
 #include "problem_info.h"
 #include "generic_individual.h"
 #include "multiobjective.h"
+#include "random.h"
+#include "checkpoint.h"
+#include "result_writer.h"
+#include "duplicates.h"
+#include "constraints.h"
+#include "variation.h"
+#include "selection.h"
+#include "termination.h"
+#include "dominance_sort.h"
+#include "bounds.h"
+#include "local_search.h"
+#include "surrogate.h"
+#include "epsilon_archive.h"
+#include "run_config.h"
+#include "profiler.h"
 
 #include <limits>
+#include <algorithm>
 
 /**
  * Esta estrutura representa um front.
@@ -42,38 +58,222 @@ struct front {
  * Este operador é utilizado para ordenar o último front que vai entrar
  * na população, se ouver mais indivíduos no front que vagas na população.
  */
-bool compareByCrownding (GenericIndividual * ind1, GenericIndividual * ind2){
+template <class Individual>
+bool compareByCrownding (const Individual * ind1, const Individual * ind2){
 
-	return ind1->fitness < ind2->fitness ||
-			(ind1->fitness == ind2->fitness && ind1->crownding > ind2->crownding);
+	if (ind1->fitness != ind2->fitness) return ind1->fitness < ind2->fitness;
+	if (ind1->crownding != ind2->crownding) return ind1->crownding > ind2->crownding;
+
+	//empate: ordem lexicográfica dos objetivos, para que a seleção do
+	//front crítico não dependa da implementação de nth_element
+	for (int j=0; j < Info::OBJECTIVES; j++) {
+		if (ind1->obj[j] != ind2->obj[j]) return ind1->obj[j] < ind2->obj[j];
+	}
+	return false;
 }
 
 /**
  * Classe que implementa o Non-Dominated Sort Genetic Algoritmo 2.
  * Esta implementação é baseada no artigo de Deb et al (2002).
+ *
+ * O parâmetro Problem é a política de problema que define o
+ * genótipo, os operadores e a avaliação (em lote) dos indivíduos.
+ *
+ * @see MulticastProblem
  */
+template <class Problem>
 class Nsga2 {
 
 public:
-	Nsga2 (int popsize = 10, int max_gen = 100,
-			double p_cross = 0.5, double p_mut = 0.5);
+	typedef typename Problem::genotype_type genotype_type;
+	typedef GenericIndividual<genotype_type> Individual;
+
+	Nsga2 (Problem & problem, int popsize = 10, int max_gen = 100,
+			double p_cross = 0.5, double p_mut = 0.5, uint64_t seed = 1);
+
+	/**
+	 * Cria o algoritmo a partir de uma configuração de execução:
+	 * parâmetros, objetivos, threads da ordenação, parada antecipada,
+	 * arquivo ε, busca local, checkpoints e gravação da fronteira. Os
+	 * motores configurados pertencem ao algoritmo.
+	 *
+	 * run e resume instalam os objetivos da configuração na thread em
+	 * que executam, de modo que execuções com configurações diferentes
+	 * podem ocorrer ao mesmo tempo em threads diferentes.
+	 *
+	 * @param Problem
+	 * @param RunConfig
+	 * @see RunConfig
+	 */
+	Nsga2 (Problem & problem, const RunConfig & config);
 
 	~Nsga2 ();
 
 	void run ();
+
+	/**
+	 * Habilita a gravação periódica de checkpoints. A cada interval
+	 * gerações o estado da execução é gravado em file por uma thread
+	 * em segundo plano.
+	 *
+	 * @param string file
+	 * @param int interval
+	 * @see Checkpoint
+	 */
+	void setCheckpoint (const std::string & file, int interval);
+
+	/**
+	 * Restaura o estado gravado em um checkpoint. A chamada seguinte
+	 * a run() continua a execução a partir da geração gravada,
+	 * produzindo o mesmo resultado da execução sem interrupção.
+	 *
+	 * Retorna falso se o arquivo não existe ou é incompatível com
+	 * a configuração corrente.
+	 *
+	 * @param string file
+	 * @return bool
+	 */
+	bool resume (const std::string & file);
 	void recombination ();
 	void printPop ();
 	void printPopAsPisa ();
 
 	void printArc (std::fstream &file);
 
+	/**
+	 * Envia os indivíduos não dominados para um escritor assíncrono.
+	 * Apenas os vetores de objetivos são copiados; a formatação e a
+	 * gravação ocorrem na thread do escritor.
+	 *
+	 * @param ResultWriter
+	 */
+	void printArc (ResultWriter & writer);
+
+	/**
+	 * Copia para values os vetores de objetivos dos indivíduos não
+	 * dominados da população, um indivíduo por linha. Indivíduos com
+	 * objetivos preditos (GenericIndividual::predicted) ficam de fora,
+	 * assim como em printArc.
+	 *
+	 * @param vector<double>
+	 * @param vector<double> * se não for NULL, recebe a violação de cada
+	 * indivíduo copiado
+	 * @return int quantidade de indivíduos copiados
+	 */
+	int nondominated (std::vector<double> & values, std::vector<double> * violation = NULL);
+
+	/**
+	 * Define critérios de parada além do número máximo de gerações
+	 * (limite de tempo, estagnação da fronteira).
+	 *
+	 * @param Termination
+	 */
+	void setTermination (const Termination & termination);
+
+	/**
+	 * Threads utilizadas na contagem de dominância da ordenação não
+	 * dominada. Com NULL (padrão) a contagem é serial. O pool não deve
+	 * ser o mesmo em que o algoritmo executa, por exemplo o de um
+	 * Experiment (veja ThreadPool::wait).
+	 *
+	 * @param ThreadPool *
+	 */
+	void setThreadPool (ThreadPool * pool);
+
+	/**
+	 * Estágio de busca local executado em threads auxiliares. A cada
+	 * geração os indivíduos de rank 0 são enviados ao estágio e as
+	 * soluções melhoradas já recebidas substituem os últimos indivíduos
+	 * da prole. Com NULL (padrão) não há busca local.
+	 *
+	 * @param LocalSearchStage *
+	 * @see LocalSearchStage
+	 */
+	void setLocalSearch (LocalSearchStage<Problem> * stage) { m_local = stage; }
+
+	/**
+	 * Arquivo de ε-dominância que recebe a fronteira não dominada ao fim
+	 * de cada geração. Em execuções longas o arquivo substitui a gravação
+	 * da fronteira a cada geração (printArc), com memória limitada pela
+	 * grade ε. Com NULL (padrão) não há arquivo.
+	 *
+	 * O arquivo é gravado nos checkpoints e restaurado por resume, que
+	 * deve ser chamado depois de setArchive.
+	 *
+	 * @param EpsilonArchive *
+	 * @see EpsilonArchive
+	 */
+	void setArchive (EpsilonArchive * archive) { m_archive = archive; }
+
+	/**
+	 * Perfil por fase (tempos e contadores de hardware) da execução.
+	 * Com NULL (padrão) as fases não são medidas.
+	 *
+	 * @param Profiler *
+	 * @see Profiler
+	 */
+	void setProfiler (Profiler * profiler) { m_profiler = profiler; }
+
+	/**
+	 * Arquivo de saída das fronteiras, gravadas a cada output_interval
+	 * gerações da configuração e ao fim da execução. O escritor não
+	 * pertence ao algoritmo e substitui o arquivo output da configuração.
+	 * Com NULL não há gravação.
+	 *
+	 * @param ResultWriter *
+	 * @see ResultWriter
+	 */
+	void setOutput (ResultWriter * writer) { m_output = writer; }
+
+	/**
+	 * Critérios de parada da execução; após run, reason () indica
+	 * se a execução parou antes da última geração.
+	 */
+	const Termination & termination () const { return m_termination; }
+
+	/**
+	 * Última fronteira não dominada publicada pelo algoritmo. A
+	 * fronteira é publicada ao fim de cada geração e pode ser lida
+	 * por outra thread durante run sem interromper a execução.
+	 *
+	 * @return ponteiro compartilhado para a fronteira (NULL antes da
+	 * primeira geração)
+	 */
+	std::shared_ptr<const Snapshot::Front> snapshot () const { return m_snapshot.latest (); }
+
+	/**
+	 * Configuração da execução (a dos parâmetros do construtor, se o
+	 * algoritmo não foi criado com uma RunConfig).
+	 */
+	const RunConfig & config () const { return m_config; }
+
+	/**
+	 * Arquivo de ε-dominância em uso (NULL se não há arquivo).
+	 */
+	EpsilonArchive * archive () const { return m_archive; }
+
 
 private:
 	/**
-	 * Torneio binário utilizada para escolha de indivíduos
-	 * a serem utilizados em operadores de recombinação.
+	 * Cria os motores descritos pela configuração.
+	 */
+	void configure ();
+
+	/**
+	 * Grava a fronteira na saída configurada ao fim da geração, a cada
+	 * output_interval gerações e na última geração.
+	 *
+	 * @param bool verdadeiro na última geração da execução
 	 */
-	int binary_tournament ();
+	void output (bool last);
+
+	/**
+	 * Torneio binário utilizado para escolha dos pares de indivíduos
+	 * a serem utilizados em operadores de recombinação. Os indivíduos
+	 * são comparados pelo operador de comparação por aglomeração (rank
+	 * e crowding distance). Preenche m_parents1 e m_parents2.
+	 */
+	void selection ();
 
 	/**
 	 * Procedimento para separação de indivíduos em fronteiras
@@ -89,6 +289,17 @@ private:
 	 */
 	void fast_nom_dominated_sort ();
 
+	/**
+	 * Contagem de dominância com restrições (Deb), utilizada por
+	 * fast_nom_dominated_sort quando há indivíduos inviáveis. A
+	 * dominância de Pareto é avaliada apenas entre os viáveis; cada
+	 * inviável é dominado por todos os viáveis e pelos inviáveis de
+	 * menor violação.
+	 *
+	 * @see Constraints
+	 */
+	void constrained_sort ();
+
 	/**
 	 * Método utilizado para criar os fronts. Este método tem complexidade
 	 * O(N). Ele cria os fronts com as seguintes informações:
@@ -102,6 +313,18 @@ private:
 	 */
 	void create_fronts ();
 
+	/**
+	 * Ordena m_population[0, 2N) pelo rank (fitness) com uma ordenação
+	 * por contagem, utilizando buffers mantidos entre as gerações.
+	 */
+	void sort_by_rank ();
+
+	/**
+	 * Atribui como fitness de cada indivíduo de m_index a quantidade
+	 * de indivíduos de m_index que o dominam.
+	 */
+	void count_dominance ();
+
 	/**
 	 * Método utilizado para cálcular a crownding_distance dos indivíduos de
 	 * todos os fronts. O mecanismo de cálculo da crownding_distance foi
@@ -119,8 +342,8 @@ private:
 	/**
 	 * Método utilizado para inicializar a população
 	 * O usuário da classe deve definir a forma de criação de individuos
-	 * em GenericIndividual.
-	 * @see GenericIndividual
+	 * na política de problema (Problem::create).
+	 * @see MulticastProblem
 	 */
 	void initialization ();
 
@@ -131,93 +354,359 @@ private:
 	 * esteja formada.
 	 *
 	 * O procedimento usa a crownding_distance no último front caso o mesmo possua
-	 * mais indivíduos que a população suporte como é indicado no artigo.
+	 * mais indivíduos que a população suporte como é indicado no artigo. Deste
+	 * front apenas os indivíduos necessários são selecionados (nth_element);
+	 * os fronts que não entram na população não são processados.
 	 */
 	void nextPopulation ();
 
+	/**
+	 * Avalia de verdade os sobreviventes de nextPopulation que têm
+	 * objetivos preditos (veja ScreenedProblem). Nesse caso a ordenação
+	 * e a seleção devem ser refeitas.
+	 *
+	 * @return verdadeiro se algum sobrevivente foi avaliado
+	 */
+	bool confirm ();
+
+	/**
+	 * Publica a fronteira não dominada da geração e verifica os
+	 * critérios de parada.
+	 *
+	 * @return verdadeiro se a execução deve parar
+	 */
+	bool finished ();
+
+	/**
+	 * Troca os últimos indivíduos da prole pelas soluções recebidas da
+	 * busca local e envia os indivíduos de rank 0 como novas sementes.
+	 */
+	void refine ();
+
+	/**
+	 * Avalia em lote os indivíduos do intervalo [begin, end) do
+	 * vetor da população através da política de problema.
+	 *
+	 * @param int
+	 * @param int
+	 */
+	void evaluate (int begin, int end);
+
+	/**
+	 * Monta e agenda a gravação de um checkpoint do estado atual.
+	 */
+	void checkpoint ();
+
 private:
+	Problem & m_problem;
+	RunConfig m_config;
 	int m_popsize;
 	int m_max_gen;
 	int gen;
 	int m_curr_popsize;
 	double m_prob_cross;
 	double m_prob_mut;
-	GenericIndividual **m_population;
+	Individual **m_population;
 
 	std::vector<front> fronts;
 
+	Random m_random;
+
+	std::string m_checkpoint_file;
+	int m_checkpoint_interval;
+	Checkpoint::Writer * m_writer;
+	std::vector<char> m_image;
+	bool m_resumed;
+
+	std::vector<char> m_text;
+
+	DuplicateFilter m_duplicates;
+	std::vector<char> m_duplicate;
+
+	std::vector<int> m_feasible;
+	std::vector<int> m_infeasible;
+
+	//pais selecionados para a prole da geração
+	Selection::Tournament m_tournament;
+	std::vector<uint64_t> m_keys;
+	std::vector<int> m_first;
+	std::vector<int> m_second;
+	std::vector<Individual *> m_parents1;
+	std::vector<Individual *> m_parents2;
+
+	//limites dos objetivos da população 2N
+	ObjectiveBounds m_bounds;
+
+	//sobreviventes preditos a confirmar
+	std::vector<Individual *> m_predicted;
+
+	//contagem de dominância (opcionalmente paralela)
+	DominanceSort m_sort;
+	std::vector<int> m_index;
+	std::vector<int> m_counts;
+
+	//buffers da ordenação por rank, reutilizados entre as gerações
+	std::vector<int> m_rank_count;
+	std::vector<Individual *> m_scratch;
+
+	//parada antecipada e fronteira publicada a cada geração
+	Termination m_termination;
+	Snapshot m_snapshot;
+	std::vector<double> m_front;
+	std::vector<double> m_front_violation;
+
+	//refinamento memético (opcional)
+	LocalSearchStage<Problem> * m_local;
+
+	//arquivo de ε-dominância (opcional)
+	EpsilonArchive * m_archive;
+
+	//perfil por fase (opcional)
+	Profiler * m_profiler;
+
+	//motores e saída criados a partir da configuração
+	ThreadPool * m_pool;
+	LocalSearchStage<Problem> * m_own_local;
+	EpsilonArchive * m_own_archive;
+	ResultWriter * m_own_output;
+	ResultWriter * m_output;
+
 };
 
-Nsga2::Nsga2(int popsize, int max_gen, double p_cross, double p_mut)
-	: m_popsize(popsize), m_max_gen(max_gen),
-	  m_prob_cross(p_cross), m_prob_mut (p_mut)
+template <class Problem>
+Nsga2<Problem>::Nsga2(Problem & problem, int popsize, int max_gen,
+		double p_cross, double p_mut, uint64_t seed)
+	: Nsga2 (problem, RunConfig::algorithm (popsize, 0, max_gen, p_cross, p_mut, seed))
+{
+}
+
+template <class Problem>
+Nsga2<Problem>::Nsga2(Problem & problem, const RunConfig & config)
+	: m_problem(problem), m_config (config), m_popsize(config->popsize),
+	  m_max_gen(config->generations), m_prob_cross(config->crossover),
+	  m_prob_mut (config->mutation), m_random (config->seed),
+	  m_bounds (config.objectives ()), m_sort (config.objectives (), config.sense ())
 {
 	gen = 1;
 	m_curr_popsize = m_popsize;
-	m_population = new GenericIndividual*[ 2 * m_popsize ];
+	m_population = new Individual*[ 2 * m_popsize ] ();
 
+	m_checkpoint_interval = 0;
+	m_writer = NULL;
+	m_resumed = false;
+	m_local = NULL;
+	m_archive = NULL;
+	m_profiler = NULL;
+
+	configure ();
 }
 
-Nsga2::~Nsga2() {
+template <class Problem>
+Nsga2<Problem>::~Nsga2() {
 
 	for (int i=0; i < 2 * m_popsize; ++i) {
 		delete m_population[i];
 	}
 	delete [] m_population;
 
+	delete m_writer;
+	delete m_own_output;
+	delete m_own_local;
+	delete m_own_archive;
+	delete m_pool;
+
+}
+
+template <class Problem>
+void Nsga2<Problem>::configure () {
+
+	RunConfig::Scope scope (m_config);
+	const RunSettings & s = m_config.settings ();
+
+	m_pool = NULL;
+	m_own_local = NULL;
+	m_own_archive = NULL;
+	m_own_output = NULL;
+	m_output = NULL;
+
+	if (s.sort_threads > 1) {
+		m_pool = new ThreadPool (s.sort_threads);
+		setThreadPool (m_pool);
+	}
+
+	setTermination (m_config.termination ());
+
+	if (s.epsilon_archive) {
+		m_own_archive = new EpsilonArchive (m_config.epsilon ());
+		setArchive (m_own_archive);
+	}
+
+	if (s.local_search_threads > 0) {
+		m_own_local = new LocalSearchStage<Problem> (m_problem, s.local_search_threads,
+				s.local_search_moves, s.local_search_budget, s.local_search_share, s.seed);
+		setLocalSearch (m_own_local);
+	}
+
+	if (!s.checkpoint.empty () && s.checkpoint_interval > 0) {
+		setCheckpoint (s.checkpoint, s.checkpoint_interval);
+	}
+
+	if (!s.output.empty ()) {
+		m_own_output = new ResultWriter (s.output, s.format);
+		setOutput (m_own_output);
+	}
 }
 
-void Nsga2::run() {
+template <class Problem>
+void Nsga2<Problem>::output (bool last) {
+
+	if (m_output == NULL) return;
+
+	Profiler::Section section (m_profiler, Profiler::OUTPUT);
+
+	int interval = m_config->output_interval;
+	if (last || (interval > 0 && gen % interval == 0)) printArc (*m_output);
+}
+
+template <class Problem>
+void Nsga2<Problem>::run() {
 
 #ifdef DEBUG
 	printf ("\nFunction: %s\n",__PRETTY_FUNCTION__);
 #endif
 
-	initialization();
-	recombination();
+	RunConfig::Scope scope (m_config);
+
+	m_termination.start ();
+
+	if (!m_resumed) {
+		initialization();
+		recombination();
+	}
 
-	do {
+	for (; gen <= m_max_gen; ++gen) {
 
-		fast_nom_dominated_sort();
-		nextPopulation();
+		do {
+			fast_nom_dominated_sort();
+			nextPopulation();
+		} while (confirm ());
 		recombination();
 
-	} while (++gen <= m_max_gen);
+		//o checkpoint inclui o arquivo ε já atualizado pela geração
+		bool stop = finished ();
+
+		if (m_checkpoint_interval > 0 && gen % m_checkpoint_interval == 0) {
+			checkpoint();
+		}
+
+		output (stop || gen == m_max_gen);
+		if (stop) break;
+	}
+
+}
+
+template <class Problem>
+void Nsga2<Problem>::setCheckpoint (const std::string & file, int interval) {
+
+	m_checkpoint_file = file;
+	m_checkpoint_interval = interval;
+	if (m_writer == NULL) m_writer = new Checkpoint::Writer;
+}
+
+template <class Problem>
+void Nsga2<Problem>::checkpoint () {
+
+	Profiler::Section section (m_profiler, Profiler::OUTPUT);
+
+	std::vector<Checkpoint::Front> f (fronts.size ());
+	for (unsigned i = 0; i < fronts.size (); ++i) {
+		f[i].index = fronts[i].index;
+		f[i].counter = fronts[i].counter;
+		f[i].begin = fronts[i].begin;
+		f[i].end = fronts[i].end;
+	}
+
+	//o checkpoint é gravado após a geração gen, a execução continua em gen + 1
+	Checkpoint::Header header;
+	header.algorithm = Checkpoint::NSGA2;
+	header.generation = gen + 1;
+	header.popsize = m_popsize;
+	header.arcsize = 0;
+
+	Checkpoint::build (m_image, header, m_random, m_problem,
+			m_population, 2 * m_popsize, f, m_archive);
+	m_writer->submit (m_checkpoint_file, m_image);
+}
+
+template <class Problem>
+bool Nsga2<Problem>::resume (const std::string & file) {
+
+	RunConfig::Scope scope (m_config);
+
+	Checkpoint::Reader reader (file);
+	if (!reader.valid ()) return false;
+
+	const Checkpoint::Header & header = reader.header ();
+	if (header.algorithm != Checkpoint::NSGA2 ||
+		header.popsize != m_popsize || header.size != 2 * m_popsize) return false;
+
+	if (!m_resumed) {
+		for (int i=0; i < 2 * m_popsize; ++i) {
+			m_population[i] = new Individual;
+		}
+	}
+
+	reader.restore (m_problem, m_population, m_random);
+	m_bounds.reset (m_population, 2 * m_popsize);
+	if (m_archive != NULL) reader.restore (*m_archive);
+
+	fronts.clear ();
+	for (int i=0; i < header.fronts; ++i) {
+		const Checkpoint::Front & f = reader.fronts ()[i];
+		fronts.push_back (front (f.index, f.counter, f.begin, f.end));
+	}
 
+	gen = header.generation;
+	m_resumed = true;
+	return true;
 }
 
-void Nsga2::fast_nom_dominated_sort() {
+template <class Problem>
+void Nsga2<Problem>::fast_nom_dominated_sort() {
 
 #ifdef DEBUG
 	printf ("\nFunction: %s\n",__PRETTY_FUNCTION__);
 #endif
 
-	for (int i = 0; i < (2 * m_popsize); ++i) {
+	Profiler::Section section (m_profiler, Profiler::SORT, 2 * m_popsize);
 
-		//associação de crownding distance igual a 0
-		//sempre realizada antes do cálculo de crowndig
-		m_population[i]->crownding = 0.0;
-		m_population[i]->fitness = 0.0;
+	//duplicados não participam da contagem e vão para o último front
+	m_duplicates.mark (m_population, 2 * m_popsize, m_duplicate);
 
-		for (int j = 0; j < i; ++j) {
-			if (i == j) continue;
+	if (Constraints::partition (m_population, 2 * m_popsize,
+			m_feasible, m_infeasible) > 0) {
 
-			if (MultiObjective::dominate(
-					m_population[i]->obj,
-					m_population[j]->obj) )
-			{
-				m_population[j]->fitness++;
+		constrained_sort ();
 
-			} else if (MultiObjective::dominate(
-					m_population[j]->obj,
-					m_population[i]->obj) ) {
+	} else {
 
-				m_population[i]->fitness++;
-			}
+		for (int i = 0; i < (2 * m_popsize); ++i) {
+
+			//associação de crownding distance igual a 0
+			//sempre realizada antes do cálculo de crowndig
+			m_population[i]->crownding = 0.0;
+			m_population[i]->fitness = m_duplicate[i] ? 2 * m_popsize : 0.0;
 		}
+
+		m_index.clear ();
+		for (int i = 0; i < (2 * m_popsize); ++i) {
+			if (!m_duplicate[i]) m_index.push_back (i);
+		}
+
+		count_dominance ();
 	}
 
-	std::sort (m_population,m_population + (2 * m_popsize),compareByFitness);
+	sort_by_rank ();
 
 #ifdef DEBUG
 	printPop ();
@@ -229,7 +718,85 @@ void Nsga2::fast_nom_dominated_sort() {
 
 }
 
-void Nsga2::create_fronts() {
+template <class Problem>
+void Nsga2<Problem>::constrained_sort() {
+
+	for (int i = 0; i < (2 * m_popsize); ++i) {
+		m_population[i]->crownding = 0.0;
+		m_population[i]->fitness = m_duplicate[i] ? 2 * m_popsize : 0.0;
+	}
+
+	//partição viável: dominância de Pareto
+	m_index.clear ();
+	for (unsigned a = 0; a < m_feasible.size (); ++a) {
+		if (!m_duplicate[m_feasible[a]]) m_index.push_back (m_feasible[a]);
+	}
+
+	count_dominance ();
+	int feasible = (int) m_index.size ();
+
+	//partição inviável (ordenada por violação): dominados por todos os
+	//viáveis e pelos inviáveis de violação estritamente menor
+	int processed = 0;
+	int smaller = 0;
+	double last = -1.0;
+	for (unsigned k = 0; k < m_infeasible.size (); ++k) {
+
+		int i = m_infeasible[k];
+		if (m_population[i]->violation != last) {
+			smaller = processed;
+			last = m_population[i]->violation;
+		}
+		if (m_duplicate[i]) continue;
+
+		m_population[i]->fitness = feasible + smaller;
+		processed++;
+	}
+
+}
+
+template <class Problem>
+void Nsga2<Problem>::sort_by_rank() {
+
+	const int size = 2 * m_popsize;
+
+	//os ranks são inteiros em [0, 2N]: ordenação por contagem estável
+	m_rank_count.assign (size + 2, 0);
+	for (int i = 0; i < size; ++i) {
+		int rank = std::min ((int) m_population[i]->fitness, size);
+		m_rank_count[rank + 1]++;
+	}
+	for (int r = 1; r <= size + 1; ++r) {
+		m_rank_count[r] += m_rank_count[r - 1];
+	}
+
+	m_scratch.resize (size);
+	for (int i = 0; i < size; ++i) {
+		int rank = std::min ((int) m_population[i]->fitness, size);
+		m_scratch[m_rank_count[rank]++] = m_population[i];
+	}
+
+	std::copy (m_scratch.begin (), m_scratch.end (), m_population);
+}
+
+template <class Problem>
+void Nsga2<Problem>::count_dominance() {
+
+	if (m_index.empty ()) return;
+
+	m_sort.count (m_population, &m_index[0], (int) m_index.size (), m_counts);
+	for (unsigned k = 0; k < m_index.size (); ++k) {
+		m_population[m_index[k]]->fitness = m_counts[k];
+	}
+}
+
+template <class Problem>
+void Nsga2<Problem>::setThreadPool (ThreadPool * pool) {
+	m_sort.setThreadPool (pool);
+}
+
+template <class Problem>
+void Nsga2<Problem>::create_fronts() {
 
 #ifdef DEBUG
 	printf ("\nFunction: %s\n",__PRETTY_FUNCTION__);
@@ -270,29 +837,30 @@ void Nsga2::create_fronts() {
 }
 
 
-void Nsga2::crownding_distance(int begin, int end) {
+template <class Problem>
+void Nsga2<Problem>::crownding_distance(int begin, int end) {
 #ifdef DEBUG
 	printf ("\nFunction: %s\n",__PRETTY_FUNCTION__);
 #endif
 
+	Profiler::Section section (m_profiler, Profiler::DENSITY, end - begin + 1);
 
 	for (int objective = 0; objective < Info::OBJECTIVES; ++objective) {
 
-		//usa função que compara por objetivo
+		//usa função que compara por objetivo; a ordenação estável mantém
+		//a ordem anterior nos empates (reprodutível, veja reproducible.h)
 		//end + 1 indica o fim da front
-		std::sort (m_population + begin, m_population + (end+1), compareByObjective( objective ) );
-
-		double max = m_population[ end ]->obj[ objective ];
-		double min = m_population[ begin ]->obj[ objective ];
+		std::stable_sort (m_population + begin, m_population + (end+1), compareByObjective( objective ) );
 
 		//m_population[ begin ]->crownding = numeric_limits<double>::max ();
 		m_population[ begin ]->crownding = 100000;
 		m_population[ end ]->crownding = m_population[ begin ]->crownding;
 
-		double denom = max - min;
+		//normalização pelos limites do objetivo na população (Deb et al, 2002)
+		double scale = m_bounds.scale (objective);
 
 		for (int i = (begin + 1); i < end; ++i) {
-			m_population[i]->crownding += ( m_population[ i+1 ]->obj[ objective ] - m_population[ i-1 ]->obj[ objective ] ) / denom;
+			m_population[i]->crownding += ( m_population[ i+1 ]->obj[ objective ] - m_population[ i-1 ]->obj[ objective ] ) * scale;
 		}
 	}
 
@@ -309,23 +877,36 @@ void Nsga2::crownding_distance(int begin, int end) {
 }
 
 //usa o crownding distance se necessário
-void Nsga2::nextPopulation() {
+template <class Problem>
+void Nsga2<Problem>::nextPopulation() {
 #ifdef DEBUG
 	printf ("\nFunction: %s\n",__PRETTY_FUNCTION__);
 #endif
 
+	Profiler::Section section (m_profiler, Profiler::SELECTION, 2 * m_popsize);
+
+	//apenas os fronts que entram na próxima população são processados
 	int size = 0;
 	int f = 0;
-	bool needCrownding = false;
 	while (size < m_popsize) {
 
 		crownding_distance(fronts[f].begin,fronts[f].end);
 
-		if (size + fronts[f].counter > m_popsize) {
-			needCrownding = true;
-			break;
-		}
-		else if (size + fronts[f].counter == m_popsize){
+		int remaining = m_popsize - size;
+		if (fronts[f].counter > remaining) {
+
+#ifdef DEBUG
+			cout << "Aplicar crownding distante ao front: " << f << endl;
+			cout << "Population size: " << size << endl;
+			cout << "It needs of " << remaining << " elements\n";
+#endif
+
+			/* Seleciona os remaining indivíduos de maior crowding_distance do
+			 * front crítico, que passam a ocupar o início do front. Não é
+			 * necessário ordenar o restante do front */
+			std::nth_element (m_population + fronts[f].begin,
+					m_population + fronts[f].begin + remaining,
+					m_population + (fronts[f].end + 1), compareByCrownding<Individual>);
 			break;
 		}
 
@@ -333,134 +914,221 @@ void Nsga2::nextPopulation() {
 		f++;
 	}
 
-	if (needCrownding) {
-
 #ifdef DEBUG
-		cout << "Aplicar crownding distante ao front: " << f << endl;
-		cout << "Population size: " << size << endl;
-		cout << "It needs of " << m_popsize - size << " elements\n";
+	printPop();
 #endif
 
-		/* Ordena o font pela crowding_distance, isso garante a escolha dos indivíduos
-		 * corretos para entrar na população */
-		std::sort (m_population + fronts[f].begin,
-				m_population + (fronts[f].end + 1), compareByCrownding);
+}
+
+
+template <class Problem>
+bool Nsga2<Problem>::confirm() {
 
+	m_predicted.clear ();
+	for (int i = 0; i < m_popsize; ++i) {
+		if (m_population[i]->predicted) m_predicted.push_back (m_population[i]);
 	}
+	if (m_predicted.empty ()) return false;
 
-#ifdef DEBUG
-	printPop();
-#endif
+	Profiler::Section section (m_profiler, Profiler::EVALUATION, (int) m_predicted.size ());
 
-}
+	for (unsigned i = 0; i < m_predicted.size (); ++i) m_bounds.erase (m_predicted[i]);
+	int confirmed = Screening::confirm (m_problem, &m_predicted[0], (int) m_predicted.size ());
+	for (unsigned i = 0; i < m_predicted.size (); ++i) m_bounds.insert (m_predicted[i]);
 
+	return confirmed > 0;
+}
 
-void Nsga2::initialization() {
+template <class Problem>
+void Nsga2<Problem>::initialization() {
 
 #ifdef DEBUG
 	printf ("\nFunction: %s\n",__PRETTY_FUNCTION__);
 #endif
 
+	Profiler::Section section (m_profiler, Profiler::INITIALIZATION, m_popsize);
+
 	for (int var = 0; var < m_popsize; ++var) {
-		m_population[var] = new GenericIndividual;
+		m_population[var] = new Individual;
 		m_population[var]->index = var;
+		m_problem.create (m_population[var]->genotype, m_random);
 	}
 
 	for (int var = m_popsize; var < 2*m_popsize; ++var) {
-		m_population[var] = new GenericIndividual(false);
+		m_population[var] = new Individual;
 		m_population[var]->index = var;
 	}
 
+	evaluate (0, m_popsize);
+
 }
 
-void Nsga2::recombination() {
+template <class Problem>
+void Nsga2<Problem>::evaluate (int begin, int end) {
+
+	Profiler::Section section (m_profiler, Profiler::EVALUATION, end - begin);
+
+	//com a população 2N completa os indivíduos avaliados substituem
+	//indivíduos descartados, que deixam os limites dos objetivos
+	bool replace = m_bounds.size () == 2 * m_popsize;
+	for (int i = begin; replace && i < end; ++i) {
+		m_bounds.erase (m_population[i]);
+	}
+
+	m_problem.evaluate (m_population + begin, end - begin);
+
+	for (int i = begin; i < end; ++i) {
+		m_bounds.insert (m_population[i]);
+	}
+}
+
+template <class Problem>
+void Nsga2<Problem>::recombination() {
 
 #ifdef DEBUG
 	printf ("\nFunction: %s\n",__PRETTY_FUNCTION__);
 #endif
 
+	Profiler::Section section (m_profiler, Profiler::VARIATION, m_popsize);
 
-	for (int i=0; i < m_popsize; i++) {
-
-		GenericIndividual * ind = new GenericIndividual(false);
-
-		int _p1 = binary_tournament();
-		int _p2 = binary_tournament();
-		while (_p1 == _p2) _p2 = binary_tournament();
+	selection ();
 
-		GenericIndividual * p1 = m_population[_p1];
-		GenericIndividual * p2 = m_population[_p2];
+	//os filhos são gerados diretamente nas posições da prole
+	Individual ** children = m_population + m_popsize;
 
-		int prob_cross = rand () % 10 + 1;
+	Variation::recombine (m_problem, &m_parents1[0], &m_parents2[0], children,
+			m_popsize, m_prob_cross, m_prob_mut, m_random);
 
+	for (int i=0; i < m_popsize; i++) {
+		children[i]->index = i + m_popsize;
+		children[i]->fitness = 0.0;
+		children[i]->crownding = 0.0;
+	}
 
-		if ( ((double)prob_cross/10) <= m_prob_cross ) {
-		//do something if prob_cross is less or equal than m_prob_cross
-			
+	evaluate (m_popsize, 2 * m_popsize);
 
-		} else {
-		//do something else
-			
-		}
+	if (m_local != NULL) refine ();
 
-		ind->index = i + m_popsize;
-		ind->obj[0] = ind->mpp_ind.getObjective(0);
-		ind->obj[1] = ind->mpp_ind.getObjective(1);
+}
 
-		m_population[i + m_popsize]->assign(ind);
+template <class Problem>
+void Nsga2<Problem>::refine() {
 
-		delete ind;
+	//as soluções da busca local já avaliadas ocupam o fim da prole
+	int size = m_local->collect (m_local->limit (m_popsize));
+	for (int i = 0; i < size; ++i) {
+		Individual * target = m_population[2 * m_popsize - 1 - i];
+		m_bounds.erase (target);
+		m_local->assign (i, target);
+		m_bounds.insert (target);
 	}
 
+	for (int i = 0; i < m_popsize; ++i) {
+		if ((int)m_population[i]->fitness < 1 && !m_population[i]->predicted) {
+			m_local->submit (m_population[i]);
+		}
+	}
 }
 
-int Nsga2::binary_tournament() {
+template <class Problem>
+void Nsga2<Problem>::selection() {
 
-	int ind1 = rand () % (m_popsize);
-	int ind2 = rand () % (m_popsize);
-	while (ind1 == ind2) ind2 = rand () % (m_popsize);
+	m_keys.resize (m_popsize);
+	for (int i=0; i < m_popsize; i++) {
+		m_keys[i] = Selection::crowdedKey (m_population[i]->fitness, m_population[i]->crownding);
+	}
 
-	return (m_population[ind1]->fitness < m_population[ind2]->fitness ? ind1 : ind2);
+	m_first.resize (m_popsize);
+	m_second.resize (m_popsize);
+	m_tournament.select (&m_keys[0], m_popsize, &m_first[0], &m_second[0], m_popsize, m_random);
 
+	m_parents1.resize (m_popsize);
+	m_parents2.resize (m_popsize);
+	for (int i=0; i < m_popsize; i++) {
+		m_parents1[i] = m_population[m_first[i]];
+		m_parents2[i] = m_population[m_second[i]];
+	}
 }
 
-void Nsga2::printPop() {
+template <class Problem>
+void Nsga2<Problem>::printPop() {
 	printf("Current Population\n");
 	for (int i=0; i < (2 * m_popsize); i++) {
 		printf ("Index: %d  fitness: %f crownding: %.2f \t",
 				m_population[i]->index,
 				m_population[i]->fitness,
 				m_population[i]->crownding);
-		double obj1 = m_population[i]->mpp_ind.getObjective(0);
-		double obj2 = m_population[i]->mpp_ind.getObjective(1);
-		printf ("%f %f\n",obj1, obj2);
+		char * out = Output::formatPopulation (m_text, m_population, i, i + 1, false);
+		fwrite (m_text.data (), 1, out - m_text.data (), stdout);
 	}
 
 }
 
-void Nsga2::printPopAsPisa () {
+template <class Problem>
+void Nsga2<Problem>::printPopAsPisa () {
 
-	for (int i=0; i < (m_popsize); i++) {
-		double obj1 = m_population[i]->mpp_ind.getObjective(0);
-		double obj2 = m_population[i]->mpp_ind.getObjective(1);
-		printf ("%f %f\n",obj1, obj2);
-	}
-	printf ("\n");
+	char * out = Output::formatPopulation (m_text, m_population, 0, m_popsize, false);
+	*out++ = '\n';
+	fwrite (m_text.data (), 1, out - m_text.data (), stdout);
 }
 
 //print only non-dominated individuals do a file
-void Nsga2::printArc(std::fstream& file) {
+template <class Problem>
+void Nsga2<Problem>::printArc(std::fstream& file) {
 
-	for (int i=0; i < (m_popsize); i++) {
+	char * out = Output::formatPopulation (m_text, m_population, 0, m_popsize, true);
+	*out++ = '\n';
+	file.write (m_text.data (), out - m_text.data ());
+
+}
 
-		if ((int)m_population[i]->fitness < 1) {
-			double obj1 = m_population[i]->mpp_ind.getObjective(0);
-			double obj2 = m_population[i]->mpp_ind.getObjective(1);
-			file << obj1 << " " << obj2 << endl;
+template <class Problem>
+void Nsga2<Problem>::printArc(ResultWriter & writer) {
+
+	RunConfig::Scope scope (m_config);
+
+	ResultWriter::Block * block = writer.acquire (gen);
+	for (int i=0; i < (m_popsize); i++) {
+		if ((int)m_population[i]->fitness < 1 && !m_population[i]->predicted) {
+			block->add (m_population[i]->obj);
 		}
 	}
-	file << endl;
+	writer.push (block);
+
+}
+
+template <class Problem>
+void Nsga2<Problem>::setTermination (const Termination & termination) {
+	m_termination = termination;
+}
+
+template <class Problem>
+bool Nsga2<Problem>::finished () {
+
+	Profiler::Section section (m_profiler, Profiler::OUTPUT);
 
+	int rows = nondominated (m_front, &m_front_violation);
+	m_snapshot.publish (gen, m_front, rows);
+	if (m_archive != NULL) m_archive->insert (m_front.data (), rows, m_front_violation.data ());
+
+	return m_termination.active () && m_termination.stop (m_front.data (), rows);
+}
+
+template <class Problem>
+int Nsga2<Problem>::nondominated(std::vector<double> & values, std::vector<double> * violation) {
+
+	RunConfig::Scope scope (m_config);
+
+	values.clear ();
+	if (violation != NULL) violation->clear ();
+	for (int i=0; i < (m_popsize); i++) {
+		if ((int)m_population[i]->fitness < 1 && !m_population[i]->predicted) {
+			values.insert (values.end (), m_population[i]->obj,
+					m_population[i]->obj + Info::OBJECTIVES);
+			if (violation != NULL) violation->push_back (m_population[i]->violation);
+		}
+	}
+	return (int) (values.size () / Info::OBJECTIVES);
 }
 
 #endif /* NSGA2_H_ */
@@ -1,6 +1,9 @@
 #ifndef _MY_INDIVIDUAL_
 #define _MY_INDIVIDUAL_
 
+#include <cstdio>
+#include <cstdlib>
+#include <string>
 #include <iostream>
 #include <fstream>
 
@@ -14,9 +17,9 @@
 #include "../individual/multicastindividual.h"
 #include "../individual/mpackingoperator.h"
 #include "../algorithms/util.h"
-*/
 
 using namespace rca;
+*/
 
 namespace Info {
 
@@ -27,8 +30,68 @@ namespace Info {
 * POR EXEMPLO, O OBJETO QUE REPRESENTA A MINHA REDE FICA AQUI
 * SENDO ACESSÍVEL DURANTE O PROCESSO DE EXECUÇÃO.
 */
-int * objconf; //indica como manipular os objetivos
-int OBJECTIVES;
+
+/*
+ * Configuração dos objetivos.
+ *
+ * objconf, OBJECTIVES e epsilon são visões por thread: cada thread começa
+ * com a configuração padrão do processo (definida por ProblemInfo ou por
+ * configure) e uma execução configurada por RunConfig instala a sua
+ * própria configuração na thread em que executa (Info::Scope). Assim
+ * execuções com configurações diferentes podem ocorrer ao mesmo tempo
+ * no mesmo processo, cada uma em sua thread.
+ *
+ * As variáveis são inline: o cabeçalho pode ser incluído em várias
+ * unidades de tradução do mesmo programa.
+ */
+inline const int * default_objconf = NULL;
+inline int default_OBJECTIVES = 0;
+inline const double * default_epsilon = NULL;
+
+inline thread_local const int * objconf = default_objconf; //indica como manipular os objetivos
+inline thread_local int OBJECTIVES = default_OBJECTIVES;
+inline thread_local const double * epsilon = default_epsilon; //ε de cada objetivo (EpsilonArchive), opcional
+
+/**
+ * Define a configuração padrão do processo e a da thread corrente.
+ * Deve ser chamada antes de criar as threads que executam os
+ * algoritmos.
+ */
+inline void configure (int objectives, const int * sense, const double * eps = NULL) {
+	default_OBJECTIVES = OBJECTIVES = objectives;
+	default_objconf = objconf = sense;
+	default_epsilon = epsilon = eps;
+}
+
+/**
+ * Instala uma configuração de objetivos na thread corrente enquanto o
+ * objeto existir; o destrutor restaura a configuração anterior. Os
+ * vetores sense e eps devem existir enquanto o objeto existir.
+ */
+class Scope {
+
+public:
+	Scope (int objectives, const int * sense, const double * eps)
+		: m_objectives (OBJECTIVES), m_objconf (objconf), m_epsilon (epsilon) {
+		OBJECTIVES = objectives;
+		objconf = sense;
+		epsilon = eps;
+	}
+
+	~Scope () {
+		OBJECTIVES = m_objectives;
+		objconf = m_objconf;
+		epsilon = m_epsilon;
+	}
+
+private:
+	Scope (const Scope &);
+	Scope & operator= (const Scope &);
+
+	int m_objectives;
+	const int * m_objconf;
+	const double * m_epsilon;
+};
 
 /**
  * Classe que armazena infomações sobre o problema.
@@ -59,12 +122,19 @@ public:
 	 * indica que há três objetivos e que os dois primeiros são de
 	 * minimização e o último é maximização.
 	 *
+	 * O terceiro arquivo, opcional, indica o ε de cada objetivo
+	 * utilizado pelo arquivo de ε-dominância (EpsilonArchive), na
+	 * mesma ordem do arquivo de configuração dos objetivos:
+	 *
+	 * 						0.5 0.01 2
+	 *
 	 * @param %string file_instance
 	 * @param %string objectives_configuration
+	 * @param %string epsilon_configuration
 	 * @author Romerito Campos
 	 * @date 10/10/2012
 	 */
-	ProblemInfo (std::string file, std::string obj_conf);
+	ProblemInfo (std::string file, std::string obj_conf, std::string eps_conf = "");
 
 	/**
 	 * Destrói objetos alocados por pelo construtor da classe.
@@ -84,10 +154,14 @@ public:
 	
 private:
 	void readerObj (std::string &);
+	void readerEpsilon (std::string &);
 };
 
-ProblemInfo::ProblemInfo (std::string file, std::string obj_conf) {
+inline ProblemInfo::ProblemInfo (std::string file, std::string obj_conf, std::string eps_conf) {
 
+	//utilizados na configuração do problema abaixo
+	(void) file;
+	(void) obj_conf;
 
 //Configurando os objetos que utilizo como globais
 /*
@@ -98,6 +172,8 @@ ProblemInfo::ProblemInfo (std::string file, std::string obj_conf) {
 	reader.configProblem(mproblem);
 	readerObj (obj_conf);
 */
+
+	if (!eps_conf.empty ()) readerEpsilon (eps_conf);
 	
 }
 
@@ -115,9 +191,9 @@ ProblemInfo::ProblemInfo (std::string file, std::string obj_conf) {
 * onde todos os objetivos são tratados como sendo de 
 * minimização.
 */
-void ProblemInfo::readerObj (std::string & obj_conf) {
+inline void ProblemInfo::readerObj (std::string & obj_conf) {
 	
-	std::ifstream file_(obj_conf.c_str(), ifstream::in);	
+	std::ifstream file_(obj_conf.c_str(), std::ifstream::in);	
 	
 	if (file_.fail()) exit (1);
 	
@@ -131,16 +207,34 @@ void ProblemInfo::readerObj (std::string & obj_conf) {
 		
 	
 	file_.close ();
-	file_.open (obj_conf.c_str(), ifstream::in);
-	objconf = new int[count];
-	OBJECTIVES = count;
+	file_.open (obj_conf.c_str(), std::ifstream::in);
+	int * sense = new int[count];
 	for (int i=0; i < count; i++) {
 		file_ >> str;
-		objconf[i] = atoi(str.c_str());
+		sense[i] = atoi(str.c_str());
+	}
+	configure (count, sense, epsilon);
+}
+
+/**
+* Lê o ε de cada objetivo. O arquivo deve conter um valor
+* positivo por objetivo (OBJECTIVES valores), na ordem do
+* arquivo de configuração dos objetivos.
+*/
+inline void ProblemInfo::readerEpsilon (std::string & eps_conf) {
+
+	std::ifstream file_(eps_conf.c_str(), std::ifstream::in);
+
+	if (file_.fail()) exit (1);
+
+	double * eps = new double[OBJECTIVES];
+	for (int i=0; i < OBJECTIVES; i++) {
+		if (!(file_ >> eps[i]) || eps[i] <= 0.0) exit (1);
 	}
+	configure (OBJECTIVES, objconf, eps);
 }
 
-void ProblemInfo::printObjectives () {
+inline void ProblemInfo::printObjectives () {
 	
 	printf("Número de Objetivos: %d \n",OBJECTIVES);
 	for (int i=0; i < OBJECTIVES; i++) {
@@ -0,0 +1,293 @@
+#ifndef _PROFILER_H_
+#define _PROFILER_H_
+
+#include <stdint.h>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <chrono>
+
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+/**
+ * Perfil por fase dos algoritmos e dos benchmarks com contadores de
+ * hardware (perf_event do Linux): ciclos, instruções, faltas na cache
+ * L1 de dados e na última cache (LLC) e desvios mal previstos.
+ *
+ * Os algoritmos marcam as suas fases (ordenação, densidade, seleção,
+ * variação, avaliação, ...) com Section; as fases aninhadas são
+ * exclusivas, isto é, o tempo da avaliação dentro da variação é
+ * atribuído apenas à avaliação:
+ *
+ *		Profiler profiler;
+ *		Nsga2<MulticastProblem> nsga2 (problem, config);
+ *		nsga2.setProfiler (&profiler);
+ *		nsga2.run ();
+ *		profiler.print (stdout);
+ *
+ * O relatório traz, por fase, o tempo, o IPC (instruções por ciclo) e
+ * as faltas por indivíduo processado. Sem contadores (outro sistema,
+ * perf_event_paranoid restritivo, máquina virtual sem PMU) o perfil
+ * contém apenas os tempos; cada contador indisponível é omitido.
+ *
+ * Os contadores medem a thread que cria o Profiler e as threads criadas
+ * depois dele (ThreadPool da ordenação, LocalSearchStage, ResultWriter),
+ * que devem ser criadas após o Profiler para serem contadas. O trabalho
+ * das threads auxiliares é atribuído à fase corrente da thread do
+ * algoritmo. As fases devem ser marcadas sempre pela mesma thread.
+ *
+ * @date 18/10/2026
+ */
+class Profiler {
+
+public:
+
+	//fases marcadas pelo Nsga2 e pelo Spea2
+	enum Phase {INITIALIZATION, SORT, DENSITY, SELECTION, VARIATION, EVALUATION, OUTPUT, PHASES};
+
+	//contadores de hardware
+	enum Counter {CYCLES, INSTRUCTIONS, L1D_MISSES, LLC_MISSES, BRANCH_MISSES, COUNTERS};
+
+	/**
+	 * @param bool falso para medir apenas os tempos
+	 */
+	Profiler (bool counters = true) : m_available (0) {
+
+		static const char * names[PHASES] = {"initialization", "sort", "density",
+				"selection", "variation", "evaluation", "output"};
+		for (int p=0; p < PHASES; p++) add (names[p]);
+
+		for (int c=0; c < COUNTERS; c++) {
+			m_fd[c] = counters ? open (c) : -1;
+			if (m_fd[c] >= 0) m_available++;
+		}
+		m_mark = now ();
+	}
+
+	~Profiler () {
+#ifdef __linux__
+		for (int c=0; c < COUNTERS; c++) {
+			if (m_fd[c] >= 0) close (m_fd[c]);
+		}
+#endif
+	}
+
+	/**
+	 * Registra uma fase (por exemplo, um kernel de um benchmark).
+	 *
+	 * @return int identificador da fase
+	 */
+	int add (const std::string & name) {
+		m_phases.push_back (Totals ());
+		m_phases.back ().name = name;
+		return (int) m_phases.size () - 1;
+	}
+
+	/**
+	 * Quantidade de contadores de hardware disponíveis (zero: apenas
+	 * tempos).
+	 */
+	int available () const { return m_available; }
+
+	bool available (Counter counter) const { return m_fd[counter] >= 0; }
+
+	/**
+	 * Inicia a fase phase, que processa items indivíduos (ou vetores).
+	 * A fase corrente, se houver, é interrompida até end.
+	 */
+	void begin (int phase, uint64_t items = 0) {
+		Sample sample = now ();
+		if (!m_stack.empty ()) charge (m_stack.back (), sample);
+		m_mark = sample;
+		m_stack.push_back (phase);
+		m_phases[phase].calls++;
+		m_phases[phase].items += items;
+	}
+
+	/**
+	 * Encerra a fase iniciada por último.
+	 */
+	void end () {
+		Sample sample = now ();
+		charge (m_stack.back (), sample);
+		m_mark = sample;
+		m_stack.pop_back ();
+	}
+
+	/**
+	 * Marca uma fase enquanto o objeto existir; com profiler NULL não
+	 * faz nada.
+	 */
+	class Section {
+	public:
+		Section (Profiler * profiler, int phase, uint64_t items = 0) : m_profiler (profiler) {
+			if (m_profiler != NULL) m_profiler->begin (phase, items);
+		}
+
+		~Section () {
+			if (m_profiler != NULL) m_profiler->end ();
+		}
+
+	private:
+		Section (const Section &);
+		Section & operator= (const Section &);
+
+		Profiler * m_profiler;
+	};
+
+	double seconds (int phase) const { return m_phases[phase].seconds; }
+	uint64_t calls (int phase) const { return m_phases[phase].calls; }
+	uint64_t items (int phase) const { return m_phases[phase].items; }
+	double count (int phase, Counter counter) const { return m_phases[phase].counters[counter]; }
+
+	/**
+	 * Instruções por ciclo da fase (zero sem os dois contadores).
+	 */
+	double ipc (int phase) const {
+		const Totals & t = m_phases[phase];
+		return available (CYCLES) && available (INSTRUCTIONS) && t.counters[CYCLES] > 0.0 ?
+				t.counters[INSTRUCTIONS] / t.counters[CYCLES] : 0.0;
+	}
+
+	/**
+	 * Zera os totais de todas as fases.
+	 */
+	void reset () {
+		for (unsigned p=0; p < m_phases.size (); p++) {
+			std::string name = m_phases[p].name;
+			m_phases[p] = Totals ();
+			m_phases[p].name = name;
+		}
+	}
+
+	/**
+	 * Grava uma linha por fase executada: chamadas, segundos, IPC e
+	 * faltas por indivíduo ('-' para contadores indisponíveis).
+	 */
+	void print (FILE * out) const {
+
+		fprintf (out, "%-16s %8s %10s %6s %12s %12s %12s\n", "phase", "calls", "seconds",
+				"ipc", "l1d/item", "llc/item", "branch/item");
+
+		for (unsigned p=0; p < m_phases.size (); p++) {
+			const Totals & t = m_phases[p];
+			if (t.calls == 0) continue;
+
+			char ipc[32], l1d[32], llc[32], branch[32];
+			format (ipc, available (CYCLES) && available (INSTRUCTIONS), this->ipc (p), "%.2f");
+			double items = t.items > 0 ? (double) t.items : (double) t.calls;
+			format (l1d, available (L1D_MISSES), t.counters[L1D_MISSES] / items, "%.1f");
+			format (llc, available (LLC_MISSES), t.counters[LLC_MISSES] / items, "%.1f");
+			format (branch, available (BRANCH_MISSES), t.counters[BRANCH_MISSES] / items, "%.1f");
+
+			fprintf (out, "%-16s %8llu %10.4f %6s %12s %12s %12s\n", t.name.c_str (),
+					(unsigned long long) t.calls, t.seconds, ipc, l1d, llc, branch);
+		}
+		if (m_available == 0) fprintf (out, "(contadores de hardware indisponíveis: apenas tempos)\n");
+	}
+
+private:
+
+	struct Sample {
+		std::chrono::steady_clock::time_point time;
+		double counters[COUNTERS];
+	};
+
+	struct Totals {
+		Totals () : calls (0), items (0), seconds (0.0) {
+			for (int c=0; c < COUNTERS; c++) counters[c] = 0.0;
+		}
+
+		std::string name;
+		uint64_t calls;
+		uint64_t items;
+		double seconds;
+		double counters[COUNTERS];
+	};
+
+	static void format (char * text, bool available, double value, const char * pattern) {
+		if (available) snprintf (text, 32, pattern, value);
+		else strcpy (text, "-");
+	}
+
+	/**
+	 * Abre o contador c para a thread corrente e as threads criadas
+	 * depois (inherit).
+	 *
+	 * @return int descritor do contador ou -1 se indisponível
+	 */
+	static int open (int c) {
+#ifdef __linux__
+		struct perf_event_attr attr;
+		memset (&attr, 0, sizeof (attr));
+		attr.size = sizeof (attr);
+		attr.type = PERF_TYPE_HARDWARE;
+		attr.inherit = 1;
+		attr.exclude_kernel = 1;
+		attr.exclude_hv = 1;
+		attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+		switch (c) {
+		case CYCLES: attr.config = PERF_COUNT_HW_CPU_CYCLES; break;
+		case INSTRUCTIONS: attr.config = PERF_COUNT_HW_INSTRUCTIONS; break;
+		case LLC_MISSES: attr.config = PERF_COUNT_HW_CACHE_MISSES; break;
+		case BRANCH_MISSES: attr.config = PERF_COUNT_HW_BRANCH_MISSES; break;
+		case L1D_MISSES:
+			attr.type = PERF_TYPE_HW_CACHE;
+			attr.config = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+					(PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+			break;
+		}
+
+		long fd = syscall (__NR_perf_event_open, &attr, 0, -1, -1, 0);
+		return fd < 0 ? -1 : (int) fd;
+#else
+		return -1;
+#endif
+	}
+
+	/**
+	 * Valor do contador c, corrigido pela multiplexação (fração do tempo
+	 * em que o contador esteve ativo).
+	 */
+	double read (int c) const {
+#ifdef __linux__
+		uint64_t values[3];
+		if (m_fd[c] < 0 || ::read (m_fd[c], values, sizeof (values)) != (ssize_t) sizeof (values)) return 0.0;
+		if (values[2] == 0) return 0.0;
+		return (double) values[0] * ((double) values[1] / (double) values[2]);
+#else
+		return 0.0;
+#endif
+	}
+
+	Sample now () const {
+		Sample sample;
+		sample.time = std::chrono::steady_clock::now ();
+		for (int c=0; c < COUNTERS; c++) sample.counters[c] = read (c);
+		return sample;
+	}
+
+	/**
+	 * Atribui à fase phase o intervalo entre a última marcação e sample.
+	 */
+	void charge (int phase, const Sample & sample) {
+		Totals & t = m_phases[phase];
+		t.seconds += std::chrono::duration<double> (sample.time - m_mark.time).count ();
+		for (int c=0; c < COUNTERS; c++) t.counters[c] += sample.counters[c] - m_mark.counters[c];
+	}
+
+	int m_fd[COUNTERS];
+	int m_available;
+
+	std::vector<Totals> m_phases;
+	std::vector<int> m_stack;
+	Sample m_mark;
+};
+
+#endif
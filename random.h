@@ -0,0 +1,115 @@
+#ifndef _RANDOM_H_
+#define _RANDOM_H_
+
+#include <stdint.h>
+#include <cstddef>
+
+/**
+ * Gerador de números pseudo-aleatórios utilizado pelos algoritmos.
+ *
+ * A implementação é o xoshiro256** (Blackman e Vigna). O estado
+ * completo do gerador são quatro palavras de 64 bits armazenadas
+ * em state, o que permite salvar e restaurar o gerador (checkpoint)
+ * e criar fluxos independentes para cada execução.
+ *
+ * Diferente de rand(), cada algoritmo possui o seu próprio gerador,
+ * portanto duas execuções no mesmo processo não interferem entre si.
+ *
+ * @date 18/10/2026
+ */
+class Random {
+
+public:
+
+	/**
+	 * Inicializa o gerador a partir de uma semente.
+	 * @param uint64_t seed
+	 */
+	Random (uint64_t seed = 1) {
+		setSeed (seed);
+	}
+
+	/**
+	 * Reinicia o estado do gerador a partir de uma semente. O estado
+	 * é expandido com o splitmix64 para evitar estados nulos.
+	 *
+	 * @param uint64_t seed
+	 */
+	void setSeed (uint64_t seed) {
+		for (int i=0; i < 4; i++) {
+			seed += 0x9e3779b97f4a7c15ULL;
+			uint64_t z = seed;
+			z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+			z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+			state[i] = z ^ (z >> 31);
+		}
+	}
+
+	/**
+	 * Retorna os próximos 64 bits aleatórios.
+	 */
+	uint64_t next () {
+
+		const uint64_t result = rotl (state[1] * 5, 7) * 9;
+		const uint64_t t = state[1] << 17;
+
+		state[2] ^= state[0];
+		state[3] ^= state[1];
+		state[1] ^= state[2];
+		state[0] ^= state[3];
+		state[2] ^= t;
+		state[3] = rotl (state[3], 45);
+
+		return result;
+	}
+
+	/**
+	 * Retorna um inteiro uniforme no intervalo [0, n).
+	 * @param int n
+	 * @return int
+	 */
+	int nextInt (int n) {
+		return (int)(((next () >> 32) * (uint64_t)n) >> 32);
+	}
+
+	/**
+	 * Retorna um real uniforme no intervalo [0, 1).
+	 * @return double
+	 */
+	double nextDouble () {
+		return (next () >> 11) * (1.0 / 9007199254740992.0);
+	}
+
+	/**
+	 * Preenche out com n reais uniformes em [0, 1). Sortear os números
+	 * em lote permite que os laços que os consomem sejam vetorizados.
+	 */
+	void fill (double * out, size_t n) {
+		for (size_t i=0; i < n; i++) {
+			out[i] = nextDouble ();
+		}
+	}
+
+	/**
+	 * Preenche out com n palavras aleatórias de 64 bits.
+	 */
+	void fill (uint64_t * out, size_t n) {
+		for (size_t i=0; i < n; i++) {
+			out[i] = next ();
+		}
+	}
+
+	/**
+	 * Estado do gerador. Pode ser copiado livremente para salvar
+	 * e restaurar a sequência.
+	 */
+	uint64_t state[4];
+
+private:
+	static uint64_t rotl (uint64_t x, int k) {
+		return (x << k) | (x >> (64 - k));
+	}
+
+};
+
+#endif
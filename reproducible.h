@@ -0,0 +1,159 @@
+#ifndef _REPRODUCIBLE_H_
+#define _REPRODUCIBLE_H_
+
+#include <stdint.h>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include "thread_pool.h"
+#include "run_config.h"
+
+/**
+ * Camada de reprodutibilidade: reduções em ordem fixa e verificação de
+ * que uma execução não depende da quantidade de threads.
+ *
+ * Somas de ponto flutuante não são associativas: uma soma paralela que
+ * divide o vetor pela quantidade de threads produz resultados diferentes
+ * com 1, 2 ou 8 threads. As reduções daqui dividem o vetor em blocos de
+ * tamanho fixo (BLOCK), somam cada bloco da esquerda para a direita e
+ * combinam os resultados dos blocos por uma árvore de pares fixa. Os
+ * blocos podem ser somados em paralelo; a ordem das operações depende
+ * apenas do tamanho do vetor, de modo que o resultado é o mesmo, bit a
+ * bit, com qualquer quantidade de threads (ou sem threads).
+ *
+ * As ordenações dos algoritmos que decidem a seleção (crowding distance
+ * do Nsga2, truncamento do Spea2) são estáveis ou desempatam pelo índice,
+ * de modo que o resultado também não depende da implementação de
+ * std::sort.
+ *
+ * verify executa a mesma configuração (mesma semente) com várias
+ * quantidades de threads e compara as fronteiras bit a bit:
+ *
+ *		RunConfig config;
+ *		RunConfig::load ("b30.conf", config);
+ *		bool same = Reproducible::verify<Nsga2<MulticastProblem> > (problem, config);
+ *
+ * @date 18/10/2026
+ */
+namespace Reproducible {
+
+	//tamanho dos blocos das reduções (independe da quantidade de threads)
+	enum {BLOCK = 1024};
+
+	/**
+	 * Combina os valores de partial em ordem fixa: em cada rodada o
+	 * valor i recebe o valor i + step.
+	 */
+	template <class T, class Op>
+	T combine (std::vector<T> & partial, Op op) {
+		const int n = (int) partial.size ();
+		for (int step=1; step < n; step *= 2) {
+			for (int i=0; i + step < n; i += 2 * step) {
+				partial[i] = op (partial[i], partial[i + step]);
+			}
+		}
+		return partial[0];
+	}
+
+	/**
+	 * Redução de values[0, size) pela operação op (associativa a menos
+	 * de arredondamento) em ordem fixa. Com pool os blocos são reduzidos
+	 * em paralelo; o resultado é idêntico ao da redução serial.
+	 *
+	 * @param T identidade de op (resultado de uma redução vazia)
+	 */
+	template <class T, class Op>
+	T reduce (const T * values, int size, T identity, Op op, ThreadPool * pool = NULL) {
+
+		if (size <= 0) return identity;
+
+		const int blocks = (size + BLOCK - 1) / BLOCK;
+		std::vector<T> partial (blocks, identity);
+
+		auto block = [values, size, &partial, op] (int b) {
+			int begin = b * BLOCK;
+			int end = std::min (size, begin + (int) BLOCK);
+			T value = values[begin];
+			for (int i=begin + 1; i < end; i++) value = op (value, values[i]);
+			partial[b] = value;
+		};
+
+		if (pool != NULL && pool->size () > 1 && blocks > 1) {
+			int tasks = std::min (blocks, pool->size ());
+			for (int t=0; t < tasks; t++) {
+				pool->submit ([&block, t, tasks, blocks] {
+					for (int b=t; b < blocks; b += tasks) block (b);
+				});
+			}
+			pool->wait ();
+		} else {
+			for (int b=0; b < blocks; b++) block (b);
+		}
+
+		return combine (partial, op);
+	}
+
+	/**
+	 * Soma de values[0, size) em ordem fixa.
+	 */
+	inline double sum (const double * values, int size, ThreadPool * pool = NULL) {
+		return reduce (values, size, 0.0, [] (double a, double b) { return a + b; }, pool);
+	}
+
+	/**
+	 * Verdadeiro se os vetores são iguais bit a bit (0.0 e -0.0 são
+	 * diferentes, NaN é igual a si mesmo).
+	 */
+	inline bool identical (const std::vector<double> & a, const std::vector<double> & b) {
+		return a.size () == b.size () &&
+				(a.empty () || memcmp (&a[0], &b[0], a.size () * sizeof (double)) == 0);
+	}
+
+	/**
+	 * Executa a configuração config com cada quantidade de threads de
+	 * threads (sort_threads) e compara as fronteiras não dominadas
+	 * (nondominated) com a da primeira execução. A saída, o checkpoint
+	 * e a busca local da configuração são desativados, já que a busca
+	 * local não é reproduzível pela semente.
+	 *
+	 * Algorithm deve possuir o construtor (Problem &, const RunConfig &),
+	 * run () e nondominated (std::vector<double> &), como Nsga2 e Spea2.
+	 *
+	 * @return bool verdadeiro se todas as fronteiras são idênticas; as
+	 * diferenças são descritas em stderr
+	 */
+	template <class Algorithm, class Problem>
+	bool verify (Problem & problem, const RunConfig & config,
+			const std::vector<int> & threads = std::vector<int> {1, 2, 8, 64})
+	{
+		std::vector<double> reference, front;
+		bool same = true;
+
+		for (unsigned t=0; t < threads.size (); t++) {
+
+			RunSettings settings = config.settings ();
+			settings.sort_threads = threads[t];
+			settings.output.clear ();
+			settings.checkpoint.clear ();
+			settings.local_search_threads = 0;
+
+			Problem copy = problem;
+			Algorithm algorithm (copy, RunConfig (settings));
+			algorithm.run ();
+			int rows = algorithm.nondominated (t == 0 ? reference : front);
+
+			if (t > 0 && !identical (reference, front)) {
+				fprintf (stderr, "Reproducible: %d threads: fronteira de %d vetores difere da de %d threads\n",
+						threads[t], rows, threads[0]);
+				same = false;
+			}
+		}
+		return same;
+	}
+
+}
+
+#endif
@@ -0,0 +1,252 @@
+#ifndef _RESULT_WRITER_H_
+#define _RESULT_WRITER_H_
+
+#include <stdint.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <charconv>
+#include <condition_variable>
+
+#include "problem_info.h"
+#include "lock_free_queue.h"
+#include "front_file.h"
+
+/**
+ * Funções de formatação de resultados.
+ *
+ * Os valores são formatados com std::to_chars, que produz a menor
+ * representação decimal que recupera exatamente o double, sem
+ * passar pelo locale nem por printf.
+ */
+namespace Output {
+
+	enum Format {PISA = 0, BINARY = 1, BINARY_DELTA = 2};
+
+	/**
+	 * Tamanho máximo de um double formatado (incluindo o separador).
+	 */
+	enum {DOUBLE_CHARS = 32};
+
+	inline char * formatDouble (char * out, double value) {
+		return std::to_chars (out, out + DOUBLE_CHARS, value).ptr;
+	}
+
+	/**
+	 * Formata uma linha no formato do PISA: os M objetivos separados
+	 * por espaço e terminados por '\n'. O buffer out deve possuir ao
+	 * menos M * DOUBLE_CHARS posições.
+	 *
+	 * @return ponteiro para o fim da linha formatada
+	 */
+	inline char * formatRow (char * out, const double * row, int M) {
+		for (int j=0; j < M; j++) {
+			out = formatDouble (out, row[j]);
+			*out++ = (j + 1 < M ? ' ' : '\n');
+		}
+		return out;
+	}
+
+	/**
+	 * Formata os objetivos dos indivíduos de [begin, end) em text, uma
+	 * linha por indivíduo. Se nondominated for verdadeiro apenas os
+	 * indivíduos com fitness menor que 1 e objetivos avaliados (não
+	 * preditos) são formatados.
+	 *
+	 * O buffer text é redimensionado para comportar todas as linhas e
+	 * mais um caractere, que o chamador pode usar para a linha em branco
+	 * que separa fronteiras no formato do PISA.
+	 *
+	 * @return ponteiro para o fim do texto formatado
+	 */
+	template <class Individual>
+	char * formatPopulation (std::vector<char> & text, Individual ** population,
+			int begin, int end, bool nondominated)
+	{
+		const int M = Info::OBJECTIVES;
+		text.resize ((size_t) (end - begin) * M * DOUBLE_CHARS + 1);
+
+		char * out = text.data ();
+		for (int i = begin; i < end; i++) {
+			if (nondominated && (population[i]->fitness >= 1.0 || population[i]->predicted)) continue;
+			out = formatRow (out, population[i]->obj, M);
+		}
+		return out;
+	}
+}
+
+/**
+ * Escritor assíncrono de resultados.
+ *
+ * A thread do algoritmo apenas copia os vetores de objetivos para um
+ * bloco (snapshot) e o coloca em uma fila sem bloqueio. Uma thread em
+ * segundo plano formata e grava os blocos, em texto no formato do PISA
+ * ou no formato binário colunar (ver front_file.h). Os blocos já gravados retornam por
+ * uma segunda fila e são reaproveitados, assim o regime permanente não
+ * aloca memória.
+ *
+ * Uso:
+ *
+ *		ResultWriter writer ("front.txt");
+ *		...
+ *		nsga2.printArc (writer);	//a cada geração
+ *
+ * @see Output
+ */
+class ResultWriter {
+
+public:
+
+	/**
+	 * Snapshot de uma fronteira: rows vetores de objetivos armazenados
+	 * linha a linha em values.
+	 */
+	struct Block {
+		int generation;
+		int rows;
+		std::vector<double> values;
+
+		void add (const double * row) {
+			values.insert (values.end (), row, row + Info::OBJECTIVES);
+			rows++;
+		}
+	};
+
+	/**
+	 * Abre o arquivo de saída e inicia a thread de escrita.
+	 *
+	 * @param string file
+	 * @param Format formato de saída (PISA, BINARY ou BINARY_DELTA)
+	 * @param size_t quantidade máxima de blocos na fila
+	 * @param uint64_t identificador da execução gravado nos blocos binários
+	 */
+	ResultWriter (const std::string & file, Output::Format format = Output::PISA,
+			size_t capacity = 64, uint64_t run = 0)
+		: m_format (format), m_objectives (Info::OBJECTIVES), m_run (run),
+		  m_queue (capacity), m_free (capacity), m_stop (false)
+	{
+		m_file = fopen (file.c_str (), format == Output::PISA ? "w" : "wb");
+		if (m_file != NULL) {
+			setvbuf (m_file, NULL, _IOFBF, 1 << 20);
+			if (format != Output::PISA) {
+				FrontFile::writeHeader (m_file, m_objectives, Info::objconf);
+			}
+		}
+		m_thread = std::thread (&ResultWriter::loop, this);
+	}
+
+	/**
+	 * Grava todos os blocos pendentes e fecha o arquivo.
+	 */
+	~ResultWriter () {
+
+		m_stop.store (true);
+		m_cond.notify_one ();
+		m_thread.join ();
+
+		Block * block;
+		while (m_free.pop (block)) delete block;
+		if (m_file != NULL) fclose (m_file);
+	}
+
+	bool good () const {
+		return m_file != NULL;
+	}
+
+	/**
+	 * Retorna um bloco vazio para ser preenchido pela thread do
+	 * algoritmo. O bloco deve ser devolvido através de push.
+	 */
+	Block * acquire (int generation) {
+
+		Block * block;
+		if (!m_free.pop (block)) block = new Block;
+
+		block->generation = generation;
+		block->rows = 0;
+		block->values.clear ();
+		return block;
+	}
+
+	/**
+	 * Enfileira o bloco para gravação. Se a fila estiver cheia a thread
+	 * do algoritmo aguarda a thread de escrita liberar espaço.
+	 */
+	void push (Block * block) {
+
+		while (!m_queue.push (block)) {
+			m_cond.notify_one ();
+			std::this_thread::yield ();
+		}
+		m_cond.notify_one ();
+	}
+
+private:
+
+	void loop () {
+
+		while (true) {
+
+			Block * block;
+			while (m_queue.pop (block)) {
+				if (m_file != NULL) {
+					if (m_format == Output::PISA) writePisa (block);
+					else writeBinary (block);
+				}
+				if (!m_free.push (block)) delete block;
+			}
+
+			if (m_stop.load ()) {
+				if (m_queue.empty ()) break;
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lock (m_mutex);
+			m_cond.wait_for (lock, std::chrono::milliseconds (10));
+		}
+
+		if (m_file != NULL) fflush (m_file);
+	}
+
+	void writePisa (const Block * block) {
+
+		m_text.resize ((size_t) block->rows * m_objectives * Output::DOUBLE_CHARS + 1);
+
+		char * out = m_text.data ();
+		for (int i=0; i < block->rows; i++) {
+			out = Output::formatRow (out, &block->values[(size_t) i * m_objectives], m_objectives);
+		}
+		*out++ = '\n';
+
+		fwrite (m_text.data (), 1, out - m_text.data (), m_file);
+	}
+
+	void writeBinary (const Block * block) {
+
+		FrontFile::writeBlock (m_file, block->values.data (), block->rows,
+				m_objectives, block->generation, m_run,
+				m_format == Output::BINARY_DELTA ? FrontFile::DELTA : FrontFile::RAW,
+				m_text);
+	}
+
+	FILE * m_file;
+	Output::Format m_format;
+	int m_objectives;
+	uint64_t m_run;
+
+	SpscQueue<Block *> m_queue;	//algoritmo -> escrita
+	SpscQueue<Block *> m_free;	//escrita -> algoritmo (reaproveitamento)
+
+	std::thread m_thread;
+	std::atomic<bool> m_stop;
+	std::mutex m_mutex;
+	std::condition_variable m_cond;
+
+	std::vector<char> m_text;
+};
+
+#endif
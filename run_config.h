@@ -0,0 +1,319 @@
+#ifndef _RUN_CONFIG_H_
+#define _RUN_CONFIG_H_
+
+#include <stdint.h>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <memory>
+#include <fstream>
+#include <sstream>
+
+#include "problem_info.h"
+#include "termination.h"
+#include "result_writer.h"
+
+/**
+ * Parâmetros de uma execução. Os valores padrão são os dos construtores
+ * dos algoritmos; a configuração dos objetivos (sense, epsilon) começa
+ * com a configuração da thread corrente (Info).
+ *
+ * @see RunConfig
+ */
+struct RunSettings {
+
+	RunSettings ()
+		: popsize (100), arcsize (50), generations (100), crossover (0.5), mutation (0.5), seed (1),
+		  sense (Info::objconf, Info::objconf + (Info::objconf ? Info::OBJECTIVES : 0)),
+		  epsilon (Info::epsilon, Info::epsilon + (Info::epsilon ? Info::OBJECTIVES : 0)),
+		  sort_threads (1), single_precision (false), normalize (true),
+		  grid_density (false), grid_divisions (16), epsilon_archive (false),
+		  local_search_threads (0), local_search_moves (8), local_search_budget (64),
+		  local_search_share (0.25), time_limit (0.0), stall_window (0),
+		  stall_criterion (Termination::MEMBERSHIP), stall_tolerance (0.0),
+		  format (Output::PISA), output_interval (0), checkpoint_interval (0) {}
+
+	//algoritmo
+	int popsize;
+	int arcsize;
+	int generations;
+	double crossover;
+	double mutation;
+	uint64_t seed;
+
+	//objetivos: sentido (1 minimização, -1 maximização) e ε de cada um
+	std::vector<int> sense;
+	std::vector<double> epsilon;
+
+	//motores: ordenação, densidade do Spea2, arquivo e busca local
+	int sort_threads;
+	bool single_precision;
+	bool normalize;
+	bool grid_density;
+	int grid_divisions;
+	bool epsilon_archive;
+	int local_search_threads;
+	int local_search_moves;
+	int local_search_budget;
+	double local_search_share;
+
+	//parada antecipada
+	double time_limit;
+	int stall_window;
+	Termination::Criterion stall_criterion;
+	double stall_tolerance;
+
+	//saídas: fronteira (a cada output_interval gerações e ao fim) e checkpoints
+	std::string output;
+	Output::Format format;
+	int output_interval;
+	std::string checkpoint;
+	int checkpoint_interval;
+};
+
+/**
+ * Configuração imutável de uma execução.
+ *
+ * Os algoritmos recebem a configuração no construtor e guardam uma cópia.
+ * As cópias compartilham os mesmos parâmetros (somente leitura), de modo
+ * que várias execuções, com a mesma configuração ou com configurações
+ * diferentes, podem ocorrer em paralelo no mesmo processo. Durante run e
+ * resume o algoritmo instala a configuração dos objetivos na sua thread
+ * (Info::Scope).
+ *
+ * A configuração pode ser lida de um arquivo texto com uma chave por
+ * linha ('#' inicia um comentário):
+ *
+ *		popsize = 100
+ *		arcsize = 50
+ *		generations = 500
+ *		crossover = 0.9
+ *		mutation = 0.1
+ *		seed = 7
+ *		objectives = 1 1 -1
+ *		epsilon = 0.5 0.01 2
+ *		sort_threads = 4
+ *		density = single				# double (padrão), single ou grid [faixas]
+ *		normalize = 1
+ *		archive = epsilon				# none (padrão) ou epsilon
+ *		local_search = 2 8 64 0.25		# threads, vizinhos, orçamento, fração
+ *		time_limit = 3600
+ *		stall = 50 hypervolume 1e-6		# janela, hypervolume ou membership, tolerância
+ *		output = resultados/b30.txt 10	# arquivo e intervalo (0: apenas ao fim)
+ *		format = binary					# pisa (padrão), binary ou binary-delta
+ *		checkpoint = b30.ck 100
+ *
+ *		RunConfig config;
+ *		if (!RunConfig::load ("b30.conf", config)) exit (1);
+ *		Nsga2<MulticastProblem> nsga2 (problem, config);
+ *
+ * @date 18/10/2026
+ */
+class RunConfig {
+
+public:
+
+	RunConfig () : m_settings (std::make_shared<const RunSettings> ()) {}
+
+	RunConfig (const RunSettings & settings)
+		: m_settings (std::make_shared<const RunSettings> (settings)) {}
+
+	/**
+	 * Configuração equivalente aos parâmetros dos construtores antigos
+	 * dos algoritmos, com os objetivos da thread corrente.
+	 */
+	static RunConfig algorithm (int popsize, int arcsize, int generations,
+			double crossover, double mutation, uint64_t seed)
+	{
+		RunSettings settings;
+		settings.popsize = popsize;
+		settings.arcsize = arcsize;
+		settings.generations = generations;
+		settings.crossover = crossover;
+		settings.mutation = mutation;
+		settings.seed = seed;
+		return RunConfig (settings);
+	}
+
+	/**
+	 * Cópia da configuração com outra semente, por exemplo uma por
+	 * execução de um Experiment.
+	 */
+	RunConfig seeded (uint64_t seed) const {
+		RunSettings settings = *m_settings;
+		settings.seed = seed;
+		return RunConfig (settings);
+	}
+
+	/**
+	 * Lê a configuração do arquivo file. As chaves ausentes mantêm os
+	 * valores padrão.
+	 *
+	 * @return bool falso (com a linha do erro em stderr) se o arquivo não
+	 * existe, possui uma chave ou valor inválido, não define os objetivos
+	 * (nem há objetivos configurados em Info) ou pede o arquivo de
+	 * ε-dominância sem epsilon
+	 */
+	static bool load (const std::string & file, RunConfig & config) {
+
+		std::ifstream in (file.c_str ());
+		if (in.fail ()) {
+			fprintf (stderr, "%s: não foi possível ler\n", file.c_str ());
+			return false;
+		}
+
+		RunSettings s;
+		std::string line;
+		int number = 0;
+		while (std::getline (in, line)) {
+			number++;
+
+			size_t comment = line.find ('#');
+			if (comment != std::string::npos) line.erase (comment);
+
+			size_t equal = line.find ('=');
+			std::string key = trim (line.substr (0, equal));
+			if (key.empty () && equal == std::string::npos) continue;
+
+			std::istringstream value (equal == std::string::npos ? "" : line.substr (equal + 1));
+			if (!parse (key, value, s)) {
+				fprintf (stderr, "%s:%d: configuração inválida: %s\n", file.c_str (), number, line.c_str ());
+				return false;
+			}
+		}
+
+		if (s.sense.empty ()) {
+			fprintf (stderr, "%s: objectives ausente e objetivos não configurados (Info)\n", file.c_str ());
+			return false;
+		}
+
+		if (!s.epsilon.empty () && s.epsilon.size () != s.sense.size ()) {
+			fprintf (stderr, "%s: epsilon deve ter um valor por objetivo\n", file.c_str ());
+			return false;
+		}
+
+		if (s.epsilon_archive && s.epsilon.empty ()) {
+			fprintf (stderr, "%s: archive = epsilon requer epsilon\n", file.c_str ());
+			return false;
+		}
+
+		config = RunConfig (s);
+		return true;
+	}
+
+	const RunSettings & settings () const { return *m_settings; }
+	const RunSettings * operator-> () const { return m_settings.get (); }
+
+	int objectives () const { return (int) m_settings->sense.size (); }
+	const int * sense () const { return m_settings->sense.empty () ? NULL : &m_settings->sense[0]; }
+	const double * epsilon () const { return m_settings->epsilon.empty () ? NULL : &m_settings->epsilon[0]; }
+
+	/**
+	 * Critérios de parada descritos pela configuração.
+	 */
+	Termination termination () const {
+		Termination termination;
+		termination.setTimeLimit (m_settings->time_limit);
+		termination.setStall (m_settings->stall_window, m_settings->stall_criterion,
+				m_settings->stall_tolerance);
+		return termination;
+	}
+
+	/**
+	 * Objeto que instala a configuração dos objetivos na thread corrente
+	 * enquanto existir.
+	 */
+	class Scope : public Info::Scope {
+	public:
+		Scope (const RunConfig & config)
+			: Info::Scope (config.objectives (), config.sense (), config.epsilon ()) {}
+	};
+
+private:
+
+	static std::string trim (const std::string & text) {
+		size_t begin = text.find_first_not_of (" \t\r");
+		if (begin == std::string::npos) return "";
+		size_t end = text.find_last_not_of (" \t\r");
+		return text.substr (begin, end - begin + 1);
+	}
+
+	/**
+	 * Lê o valor da chave key. O valor deve ser consumido por inteiro.
+	 */
+	static bool parse (const std::string & key, std::istringstream & value, RunSettings & s) {
+
+		std::string word;
+		bool ok;
+
+		if (key == "popsize") ok = bool (value >> s.popsize);
+		else if (key == "arcsize") ok = bool (value >> s.arcsize);
+		else if (key == "generations") ok = bool (value >> s.generations);
+		else if (key == "crossover") ok = bool (value >> s.crossover);
+		else if (key == "mutation") ok = bool (value >> s.mutation);
+		else if (key == "seed") ok = bool (value >> s.seed);
+		else if (key == "sort_threads") ok = bool (value >> s.sort_threads);
+		else if (key == "normalize") ok = bool (value >> s.normalize);
+		else if (key == "time_limit") ok = bool (value >> s.time_limit);
+		else if (key == "objectives") {
+			s.sense.clear ();
+			int sense;
+			while (value >> sense) {
+				if (sense != 1 && sense != -1) return false;
+				s.sense.push_back (sense);
+			}
+			ok = !s.sense.empty () && value.eof ();
+		} else if (key == "epsilon") {
+			s.epsilon.clear ();
+			double eps;
+			while (value >> eps) {
+				if (eps <= 0.0) return false;
+				s.epsilon.push_back (eps);
+			}
+			ok = !s.epsilon.empty () && value.eof ();
+		} else if (key == "density") {
+			ok = bool (value >> word) && (word == "single" || word == "double" || word == "grid");
+			s.single_precision = word == "single";
+			s.grid_density = word == "grid";
+			if (ok && s.grid_density && !(value >> std::ws).eof ()) {
+				ok = bool (value >> s.grid_divisions) && s.grid_divisions > 0;
+			}
+		} else if (key == "archive") {
+			ok = bool (value >> word) && (word == "epsilon" || word == "none");
+			s.epsilon_archive = word == "epsilon";
+		} else if (key == "local_search") {
+			ok = bool (value >> s.local_search_threads);
+			if (ok && !(value >> std::ws).eof ()) ok = bool (value >> s.local_search_moves);
+			if (ok && !(value >> std::ws).eof ()) ok = bool (value >> s.local_search_budget);
+			if (ok && !(value >> std::ws).eof ()) ok = bool (value >> s.local_search_share);
+		} else if (key == "stall") {
+			ok = bool (value >> s.stall_window);
+			if (ok && !(value >> std::ws).eof ()) {
+				ok = bool (value >> word) && (word == "hypervolume" || word == "membership");
+				s.stall_criterion = word == "hypervolume" ? Termination::HYPERVOLUME : Termination::MEMBERSHIP;
+				if (ok && !(value >> std::ws).eof ()) ok = bool (value >> s.stall_tolerance);
+			}
+		} else if (key == "output") {
+			ok = bool (value >> s.output);
+			if (ok && !(value >> std::ws).eof ()) ok = bool (value >> s.output_interval);
+		} else if (key == "format") {
+			ok = bool (value >> word);
+			if (word == "pisa") s.format = Output::PISA;
+			else if (word == "binary") s.format = Output::BINARY;
+			else if (word == "binary-delta") s.format = Output::BINARY_DELTA;
+			else ok = false;
+		} else if (key == "checkpoint") {
+			ok = bool (value >> s.checkpoint >> s.checkpoint_interval);
+		} else {
+			return false;
+		}
+
+		//nada além do valor na linha
+		return ok && (value >> std::ws).eof ();
+	}
+
+	std::shared_ptr<const RunSettings> m_settings;
+};
+
+#endif
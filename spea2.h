@@ -5,47 +5,45 @@
 #include <cstdlib>
 #include <iostream>
 #include <limits>
-#include "../container/matrix.h"
+#include <algorithm>
 #include "generic_individual.h"
 #include "multiobjective.h"
-
-string line = "--------------------------------------------------------------";
-
-/**
- * Struct utilizada para armazenar a distância para um
- * indívuo. É utilizado para auxiliar no cálculo da
- * distância entre os indivíduos no SPEA2.
- *
- * index representa o índice do indivíduo.
- * eDist representa a distância euclidiana.
- */
-struct Ind {
-	int index;
-	double eDist; //euclidian distance	
-	Ind (int i = 0, double d = 0):index(i) , eDist(d){}	
-};
-
-/**
- * Função  que compara dois indivíduos do tipo struct Ind
- * e indica se obj1 é menor que obj2.
- * Função utilizada para ordenar os indivíduos em ordem
- * crescente.
- */
-bool compare (const struct Ind& obj1, const struct Ind& obj2)
-{
-	return obj1.eDist < obj2.eDist;
-}
+#include "random.h"
+#include "checkpoint.h"
+#include "result_writer.h"
+#include "duplicates.h"
+#include "constraints.h"
+#include "variation.h"
+#include "selection.h"
+#include "termination.h"
+#include "distance_engine.h"
+#include "grid_density.h"
+#include "local_search.h"
+#include "surrogate.h"
+#include "epsilon_archive.h"
+#include "run_config.h"
+#include "profiler.h"
+
+inline std::string line = "--------------------------------------------------------------";
 
 /**
 * Esta classe contém a implementação do SPEA2 (Strenght Pareto
 * evolutionary algoritihm 2 - 2001).
 *
+* O parâmetro Problem é a política de problema que define o
+* genótipo, os operadores e a avaliação (em lote) dos indivíduos.
+*
+* @see MulticastProblem
 * @author Romerito Campos
 * @date 10/10/2012
 */
+template <class Problem>
 class Spea2{
 	
 public: 
+	typedef typename Problem::genotype_type genotype_type;
+	typedef GenericIndividual<genotype_type> Individual;
+
 	/**
 	 * Construtor da classe Spea2. Possui trẽs parâmetro default
 	 * popzise que indica o tamanho da população utilizada.
@@ -57,12 +55,32 @@ public:
 	 * distância entre os indivíduos. Por fim, inicializa o valor
 	 * do k-ésimo vizinho mais próximo.
 	 *
+	 * @param Problem política de problema
 	 * @param int popsize
 	 * @param int arc_size
 	 * @param int max_gen
+	 * @param uint64_t seed semente do gerador aleatório
 	 */
-	Spea2 (int popsize = 100, int arc_size = 50, int max_gen = 100,
-			double p_cross = 0.5, double p_mut = 0.5);
+	Spea2 (Problem & problem, int popsize = 100, int arc_size = 50, int max_gen = 100,
+			double p_cross = 0.5, double p_mut = 0.5, uint64_t seed = 1);
+
+	/**
+	 * Cria o algoritmo a partir de uma configuração de execução:
+	 * parâmetros, objetivos, densidade (distâncias, com a sua precisão
+	 * e normalização, ou grade adaptativa),
+	 * parada antecipada, arquivo ε, busca local, checkpoints e gravação
+	 * da fronteira. Os motores configurados pertencem ao algoritmo;
+	 * sort_threads não se aplica ao Spea2.
+	 *
+	 * run e resume instalam os objetivos da configuração na thread em
+	 * que executam, de modo que execuções com configurações diferentes
+	 * podem ocorrer ao mesmo tempo em threads diferentes.
+	 *
+	 * @param Problem política de problema
+	 * @param RunConfig
+	 * @see RunConfig
+	 */
+	Spea2 (Problem & problem, const RunConfig & config);
 
 	/**
 	 * Destrutor da clase Spea2. Desaloca a memória utiliza para armazenar
@@ -77,9 +95,34 @@ public:
 	 */
 	void run ();
 
+	/**
+	 * Habilita a gravação periódica de checkpoints. A cada interval
+	 * gerações o estado da execução (população, arquivo, geração e
+	 * gerador aleatório) é gravado em file por uma thread em segundo
+	 * plano.
+	 *
+	 * @param string file
+	 * @param int interval
+	 * @see Checkpoint
+	 */
+	void setCheckpoint (const std::string & file, int interval);
+
+	/**
+	 * Restaura o estado gravado em um checkpoint. A chamada seguinte
+	 * a run() continua a execução a partir da geração gravada,
+	 * produzindo o mesmo resultado da execução sem interrupção.
+	 *
+	 * Retorna falso se o arquivo não existe ou é incompatível com
+	 * a configuração corrente.
+	 *
+	 * @param string file
+	 * @return bool
+	 */
+	bool resume (const std::string & file);
+
 	/**
 	 * Este método inicializa a população inicial do algoritmo Spea2.
-	 * Ele faz uso do construtor de soluções da classe GenericIndividual.
+	 * Ele faz uso do construtor de soluções da política de problema.
 	 */
 	void initialization (); //aberto
 
@@ -87,8 +130,8 @@ public:
 	 * Aqui é realizada a recombinação de indivíduos.
 	 * Os indíviduos são escolhidos através de torneio binário.
 	 *
-	 * O usuário deve fornecer um mecanismo de recombinação de
-	 * indivíduos.
+	 * O mecanismo de recombinação de indivíduos é fornecido
+	 * pela política de problema (crossover e mutation).
 	 */
 	void recombination (); //aberto
 
@@ -104,13 +147,157 @@ public:
 	void printArc (std::fstream&);
 	void printAsPisa ();
 
+	/**
+	 * Envia os indivíduos não dominados do arquivo para um escritor
+	 * assíncrono. Apenas os vetores de objetivos são copiados; a
+	 * formatação e a gravação ocorrem na thread do escritor.
+	 *
+	 * @param ResultWriter
+	 */
+	void printArc (ResultWriter &);
+
+	/**
+	 * Copia para values os vetores de objetivos dos indivíduos não
+	 * dominados do arquivo, um indivíduo por linha. Indivíduos com
+	 * objetivos preditos (GenericIndividual::predicted) ficam de fora,
+	 * assim como em printArc.
+	 *
+	 * @param vector<double>
+	 * @param vector<double> * se não for NULL, recebe a violação de cada
+	 * indivíduo copiado
+	 * @return int quantidade de indivíduos copiados
+	 */
+	int nondominated (std::vector<double> &, std::vector<double> * violation = NULL);
+
+	/**
+	 * Calcula as distâncias da densidade e do truncamento em precisão
+	 * simples (float), com metade da memória.
+	 *
+	 * @param bool
+	 */
+	void setSinglePrecision (bool single) { m_distances.setSinglePrecision (single); }
+
+	/**
+	 * Define se as distâncias da densidade e do truncamento usam os
+	 * objetivos normalizados pelos limites da população (padrão) ou
+	 * os valores originais dos objetivos.
+	 *
+	 * @param bool
+	 */
+	void setNormalization (bool normalize) { m_normalize = normalize; }
+
+	/**
+	 * Define critérios de parada além do número máximo de gerações
+	 * (limite de tempo, estagnação da fronteira).
+	 *
+	 * @param Termination
+	 */
+	void setTermination (const Termination & termination);
+
+	/**
+	 * Estágio de busca local executado em threads auxiliares. A cada
+	 * geração os indivíduos não dominados do arquivo são enviados ao
+	 * estágio e as soluções melhoradas já recebidas substituem os
+	 * últimos indivíduos da prole. Com NULL (padrão) não há busca local.
+	 *
+	 * @param LocalSearchStage *
+	 * @see LocalSearchStage
+	 */
+	void setLocalSearch (LocalSearchStage<Problem> * stage) { m_local = stage; }
+
+	/**
+	 * Arquivo de ε-dominância que recebe a fronteira não dominada ao fim
+	 * de cada geração. Em execuções longas o arquivo substitui a gravação
+	 * da fronteira a cada geração (printArc), com memória limitada pela
+	 * grade ε. Com NULL (padrão) não há arquivo.
+	 *
+	 * O arquivo é gravado nos checkpoints e restaurado por resume, que
+	 * deve ser chamado depois de setArchive.
+	 *
+	 * @param EpsilonArchive *
+	 * @see EpsilonArchive
+	 */
+	void setArchive (EpsilonArchive * archive) { m_archive = archive; }
+
+	/**
+	 * Perfil por fase (tempos e contadores de hardware) da execução.
+	 * Com NULL (padrão) as fases não são medidas.
+	 *
+	 * @param Profiler *
+	 * @see Profiler
+	 */
+	void setProfiler (Profiler * profiler) { m_profiler = profiler; }
+
+	/**
+	 * Arquivo de saída das fronteiras, gravadas a cada output_interval
+	 * gerações da configuração e ao fim da execução. O escritor não
+	 * pertence ao algoritmo e substitui o arquivo output da configuração.
+	 * Com NULL não há gravação.
+	 *
+	 * @param ResultWriter *
+	 * @see ResultWriter
+	 */
+	void setOutput (ResultWriter * writer) { m_output = writer; }
+
+	/**
+	 * Critérios de parada da execução; após run, reason () indica
+	 * se a execução parou antes da última geração.
+	 */
+	const Termination & termination () const { return m_termination; }
+
+	/**
+	 * Última fronteira não dominada publicada pelo algoritmo. A
+	 * fronteira é publicada ao fim de cada geração e pode ser lida
+	 * por outra thread durante run sem interromper a execução.
+	 *
+	 * @return ponteiro compartilhado para a fronteira (NULL antes da
+	 * primeira geração)
+	 */
+	std::shared_ptr<const Snapshot::Front> snapshot () const { return m_snapshot.latest (); }
+
+	/**
+	 * Configuração da execução (a dos parâmetros do construtor, se o
+	 * algoritmo não foi criado com uma RunConfig).
+	 */
+	const RunConfig & config () const { return m_config; }
+
+	/**
+	 * Arquivo de ε-dominância em uso (NULL se não há arquivo).
+	 */
+	EpsilonArchive * archive () const { return m_archive; }
+
 private:	
+	/**
+	 * Cria os motores descritos pela configuração.
+	 */
+	void configure ();
+
+	/**
+	 * Grava o arquivo na saída configurada ao fim da geração, a cada
+	 * output_interval gerações e na última geração.
+	 *
+	 * @param bool verdadeiro na última geração da execução
+	 */
+	void output (bool last);
+
 
 	/**
 	 *
 	 */
 	void fitnessAssign ();
 
+	/**
+	 * Cálculo do strength e do raw-fitness com a dominância com
+	 * restrições (Deb), utilizado por fitnessAssign quando há
+	 * indivíduos inviáveis. A dominância de Pareto é avaliada apenas
+	 * entre os viáveis; cada viável domina todos os inviáveis e cada
+	 * inviável domina os inviáveis de violação maior.
+	 *
+	 * @see Constraints
+	 * @param vector<int> strength dos indivíduos
+	 */
+	void constrainedFitness (std::vector<int> &);
+
 	/**
 	 * Função para o cálculo da densidade de todos os
 	 * indivíduos.
@@ -145,6 +332,15 @@ private:
 	 */
 	void environmentSelection ();
 
+	/**
+	 * Avalia de verdade os indivíduos do arquivo que têm objetivos
+	 * preditos (veja ScreenedProblem). Nesse caso o fitness é zerado e
+	 * a seleção ambiental deve ser refeita.
+	 *
+	 * @return verdadeiro se algum indivíduo do arquivo foi avaliado
+	 */
+	bool confirm ();
+
 	/**
 	 * Método que retorna a densidade de um indivíduo.
 	 * O cálculo é o seguinte: 1/(kth_dis + 2),
@@ -177,6 +373,17 @@ private:
 	 */
 	void truncation2 (int);
 
+	/**
+	 * Truncamento pela grade adaptativa: retira arc_size - ARCSIZE
+	 * indivíduos das células mais ocupadas do arquivo, que começa em
+	 * beginArch. Os retirados passam para antes do arquivo e os mantidos
+	 * conservam a ordem relativa, como em removal, em tempo linear.
+	 *
+	 * @param int beginArch
+	 * @param int arc_size
+	 */
+	void gridTruncation (int beginArch, int arc_size);
+
 	/**
 	 * Método para remoção de um indivíduo do arquivo.
 	 * O primeiro parâmetro indica o início do arquivo,
@@ -204,6 +411,7 @@ private:
 	 *
 	 * O primeiro parâmetro indica a nova posição do indivíduo,
 	 * o segundo parâmetro indica a antiga posição do indivíduo.
+	 * A troca é feita entre os ponteiros, sem copiar indivíduos.
 	 *
 	 * @param int
 	 * @param int
@@ -214,16 +422,46 @@ private:
 	 * Torneio binário com reposição.
 	 * Os indivíduos escolhidos para reprodução são
 	 * sorteados dentre os indivíduos do arquivo, onde
-	 * há reposição dos mesmos.
+	 * há reposição dos mesmos, e comparados pelo fitness.
+	 *
+	 * Preenche m_parents1 e m_parents2 com offspring pares
+	 * de pais distintos.
+	 *
+	 * @param int
+	 */
+	void selection (int offspring);
+
+	/**
+	 * Publica a fronteira não dominada da geração e verifica os
+	 * critérios de parada.
 	 *
-	 * O retorno é um inteiro indicando o índice que o
-	 * indivíduo possui no vetor que armazena a população.
+	 * @return verdadeiro se a execução deve parar
+	 */
+	bool finished ();
+
+	/**
+	 * Troca os últimos indivíduos da prole pelas soluções recebidas da
+	 * busca local e envia os não dominados do arquivo como novas sementes.
+	 */
+	void refine ();
+
+	/**
+	 * Avalia em lote os indivíduos do intervalo [begin, end) do
+	 * vetor da população através da política de problema.
 	 *
-	 * @return int
+	 * @param int
+	 * @param int
+	 */
+	void evaluate (int begin, int end);
+
+	/**
+	 * Monta e agenda a gravação de um checkpoint do estado atual.
 	 */
-	int binaryTournament  ();
+	void checkpoint ();
 	
 private:	
+	Problem & m_problem;
+	RunConfig m_config;
 	int POPSIZE;
 	int ARCSIZE;
 	int MAX_GEN;
@@ -233,73 +471,286 @@ private:
 
 	double m_prob_cross;
 	double m_prob_mut;
-	GenericIndividual **population;
-	vector<struct Ind> distance;
+	Individual **population;
+	//distâncias entre os vetores de objetivos (densidade e truncamento),
+	//normalizados pelos limites da população
+	DistanceEngine m_distances;
+
+	//densidade e truncamento pela grade adaptativa (RunSettings::grid_density)
+	GridDensity m_grid;
+	bool m_use_grid;
+	std::vector<char> m_removed;
+	std::vector<Individual *> m_kept;
+	ObjectiveBounds m_bounds;
+	bool m_normalize;
+
+	//indivíduos preditos do arquivo a confirmar
+	std::vector<Individual *> m_predicted;
+	std::vector<double> m_kth;
+
+	Random m_random;
+
+	std::string m_checkpoint_file;
+	int m_checkpoint_interval;
+	Checkpoint::Writer * m_writer;
+	std::vector<char> m_image;
+	bool m_resumed;
+
+	std::vector<char> m_text;
+
+	DuplicateFilter m_duplicates;
+	std::vector<char> m_duplicate;
+
+	std::vector<int> m_feasible;
+	std::vector<int> m_infeasible;
+
+	//pais selecionados para a prole da geração
+	Selection::Tournament m_tournament;
+	std::vector<uint64_t> m_keys;
+	std::vector<int> m_first;
+	std::vector<int> m_second;
+	std::vector<Individual *> m_parents1;
+	std::vector<Individual *> m_parents2;
+
+	//parada antecipada e fronteira publicada a cada geração
+	Termination m_termination;
+	Snapshot m_snapshot;
+	std::vector<double> m_front;
+	std::vector<double> m_front_violation;
+
+	//refinamento memético (opcional)
+	LocalSearchStage<Problem> * m_local;
+
+	//arquivo de ε-dominância (opcional)
+	EpsilonArchive * m_archive;
+
+	//perfil por fase (opcional)
+	Profiler * m_profiler;
+
+	//motores e saída criados a partir da configuração
+	LocalSearchStage<Problem> * m_own_local;
+	EpsilonArchive * m_own_archive;
+	ResultWriter * m_own_output;
+	ResultWriter * m_output;
 
 };
 
 
-Spea2::Spea2 (int popsize, int arc_size, int max_gen, double p_cross, double p_mut)
-	: POPSIZE(popsize), ARCSIZE (arc_size), MAX_GEN (max_gen), gen(1),
-	  m_prob_cross(p_cross), m_prob_mut (p_mut)
+template <class Problem>
+Spea2<Problem>::Spea2 (Problem & problem, int popsize, int arc_size, int max_gen,
+		double p_cross, double p_mut, uint64_t seed)
+	: Spea2 (problem, RunConfig::algorithm (popsize, arc_size, max_gen, p_cross, p_mut, seed))
+{
+}
+
+template <class Problem>
+Spea2<Problem>::Spea2 (Problem & problem, const RunConfig & config)
+	: m_problem(problem), m_config (config), POPSIZE(config->popsize), ARCSIZE (config->arcsize),
+	  MAX_GEN (config->generations), gen(1), m_prob_cross(config->crossover),
+	  m_prob_mut (config->mutation), m_distances (config->single_precision),
+	  m_grid (config->grid_divisions), m_use_grid (config->grid_density),
+	  m_bounds (config.objectives ()), m_random (config->seed)
 {
 	all_pop = POPSIZE+ARCSIZE;
-	population = new GenericIndividual*[this->all_pop];
-	distance = std::vector<Ind> (all_pop * all_pop);
+	population = new Individual*[this->all_pop] ();
 	kth = trunc (sqrt(all_pop));
 
+	m_checkpoint_interval = 0;
+	m_writer = NULL;
+	m_resumed = false;
+	m_normalize = config->normalize;
+	m_local = NULL;
+	m_archive = NULL;
+	m_profiler = NULL;
+
+	configure ();
 }
 
-Spea2::~Spea2 ()
+template <class Problem>
+Spea2<Problem>::~Spea2 ()
 {	
 	for (int i=0; i < all_pop; i++) {
 		delete population[i];
 	}
 
 	delete [] population;
+
+	delete m_writer;
+	delete m_own_output;
+	delete m_own_local;
+	delete m_own_archive;
+}
+
+template <class Problem>
+void Spea2<Problem>::configure () {
+
+	RunConfig::Scope scope (m_config);
+	const RunSettings & s = m_config.settings ();
+
+	m_own_local = NULL;
+	m_own_archive = NULL;
+	m_own_output = NULL;
+	m_output = NULL;
+
+	setTermination (m_config.termination ());
+
+	if (s.epsilon_archive) {
+		m_own_archive = new EpsilonArchive (m_config.epsilon ());
+		setArchive (m_own_archive);
+	}
+
+	if (s.local_search_threads > 0) {
+		m_own_local = new LocalSearchStage<Problem> (m_problem, s.local_search_threads,
+				s.local_search_moves, s.local_search_budget, s.local_search_share, s.seed);
+		setLocalSearch (m_own_local);
+	}
+
+	if (!s.checkpoint.empty () && s.checkpoint_interval > 0) {
+		setCheckpoint (s.checkpoint, s.checkpoint_interval);
+	}
+
+	if (!s.output.empty ()) {
+		m_own_output = new ResultWriter (s.output, s.format);
+		setOutput (m_own_output);
+	}
 }
 
-void Spea2::run () {
+template <class Problem>
+void Spea2<Problem>::output (bool last) {
+
+	if (m_output == NULL) return;
+
+	Profiler::Section section (m_profiler, Profiler::OUTPUT);
+
+	int interval = m_config->output_interval;
+	if (last || (interval > 0 && gen % interval == 0)) printArc (*m_output);
+}
+
+template <class Problem>
+void Spea2<Problem>::run () {
 	
 #ifdef DEBUG
 	printf ("\nFunction %s\n", __PRETTY_FUNCTION__ );
 #endif
+
+	RunConfig::Scope scope (m_config);
+
+	m_termination.start ();
 	
-	initialization ();
+	if (!m_resumed) {
+
+		initialization ();
 
 #ifdef DEBUG
-	printPop();
+		printPop();
 #endif
 
-	densityCalc ();
-	fitnessAssign ();
-	environmentSelection ();
-	POPSIZE = POPSIZE + ARCSIZE;
-
-	while (++gen <= MAX_GEN) {
-
-		recombination ();
 		densityCalc ();
 		fitnessAssign ();
 		environmentSelection ();
+		POPSIZE = POPSIZE + ARCSIZE;
+		++gen;
+
+		//a partir daqui os limites acompanham o arquivo e a prole
+		m_bounds.reset (population + (all_pop - ARCSIZE), ARCSIZE);
+	}
+
+	for (; gen <= MAX_GEN; ++gen) {
+
+		recombination ();
+		do {
+			densityCalc ();
+			fitnessAssign ();
+			environmentSelection ();
+		} while (confirm ());
+
+		//o checkpoint inclui o arquivo ε já atualizado pela geração
+		bool stop = finished ();
+
+		if (m_checkpoint_interval > 0 && gen % m_checkpoint_interval == 0) {
+			checkpoint ();
+		}
+
+		output (stop || gen == MAX_GEN);
+		if (stop) break;
 	}
 
 }
 
-void Spea2::initialization () {
+template <class Problem>
+void Spea2<Problem>::setCheckpoint (const std::string & file, int interval) {
+
+	m_checkpoint_file = file;
+	m_checkpoint_interval = interval;
+	if (m_writer == NULL) m_writer = new Checkpoint::Writer;
+}
+
+template <class Problem>
+void Spea2<Problem>::checkpoint () {
+
+	Profiler::Section section (m_profiler, Profiler::OUTPUT);
+
+	//o checkpoint é gravado após a geração gen, a execução continua em gen + 1
+	//o arquivo ocupa as últimas ARCSIZE posições das all_pop gravadas
+	Checkpoint::Header header;
+	header.algorithm = Checkpoint::SPEA2;
+	header.generation = gen + 1;
+	header.popsize = POPSIZE;
+	header.arcsize = ARCSIZE;
+
+	Checkpoint::build (m_image, header, m_random, m_problem,
+			population, all_pop, std::vector<Checkpoint::Front> (), m_archive);
+	m_writer->submit (m_checkpoint_file, m_image);
+}
+
+template <class Problem>
+bool Spea2<Problem>::resume (const std::string & file) {
+
+	RunConfig::Scope scope (m_config);
+
+	Checkpoint::Reader reader (file);
+	if (!reader.valid ()) return false;
+
+	const Checkpoint::Header & header = reader.header ();
+	if (header.algorithm != Checkpoint::SPEA2 ||
+		header.arcsize != ARCSIZE || header.size != all_pop) return false;
+
+	if (!m_resumed) {
+		for (int i=0; i < all_pop; i++) {
+			population[i] = new Individual;
+		}
+	}
+
+	reader.restore (m_problem, population, m_random);
+	m_bounds.reset (population, all_pop);
+	if (m_archive != NULL) reader.restore (*m_archive);
+
+	POPSIZE = header.popsize;
+	gen = header.generation;
+	m_resumed = true;
+	return true;
+}
+
+template <class Problem>
+void Spea2<Problem>::initialization () {
 	
 #ifdef DEBUG
 	printf ("\nFunction %s\n", __PRETTY_FUNCTION__ );
 #endif
 
+	Profiler::Section section (m_profiler, Profiler::INITIALIZATION, POPSIZE);
+
 	for (int i=0; i < POPSIZE; i++) {
-		population[i] = new GenericIndividual;
+		population[i] = new Individual;
 		population[i]->index = i;
+		m_problem.create (population[i]->genotype, m_random);
 	}
 	for (int i=POPSIZE; i < POPSIZE+ARCSIZE; i++) {
-		population[i] = new GenericIndividual(true);
+		population[i] = new Individual;
 	}
 
+	evaluate (0, POPSIZE);
+
 	#ifdef DEBUG
 		printPop();
 		cout << line <<endl;
@@ -307,42 +758,52 @@ void Spea2::initialization () {
 }
 
 //procedimento de fitness
-void Spea2::fitnessAssign () {
+template <class Problem>
+void Spea2<Problem>::fitnessAssign () {
 		
 #ifdef DEBUG
 	printf ("\nFunction %s\n", __PRETTY_FUNCTION__ );
 #endif
 
+	Profiler::Section section (m_profiler, Profiler::SORT, all_pop);
+
+	//duplicados recebem o pior fitness e não entram no arquivo
+	m_duplicates.mark (population, POPSIZE, m_duplicate);
 	for (int i=0; i < POPSIZE; i++) {
-		for(int j = (i+1); j < POPSIZE; ++j) {
-			if (MultiObjective::equals(population[i]->obj,
-									population[j]->obj)) {
-				population[j]->fitness = numeric_limits<long int>::max();
-			}
+		if (m_duplicate[i]) {
+			population[i]->fitness = std::numeric_limits<long int>::max();
 		}
 	}
 
-	std::vector<int> strenght = vector<int>(all_pop,0);
-	for (int i=0; i < POPSIZE; i++) {
-		for (int j=(i+1); j < POPSIZE; j++) {
+	std::vector<int> strenght = std::vector<int>(all_pop,0);
 
-			if (MultiObjective::dominate (population[i]->obj,population[j]->obj)) {
-				strenght[i]++;
-			} else if (MultiObjective::dominate (population[j]->obj,population[i]->obj)) {
-				strenght[j]++;
-			}
+	if (Constraints::partition (population, POPSIZE, m_feasible, m_infeasible) > 0) {
+
+		constrainedFitness (strenght);
 
+	} else {
+
+		for (int i=0; i < POPSIZE; i++) {
+			for (int j=(i+1); j < POPSIZE; j++) {
+
+				if (MultiObjective::dominate (population[i]->obj,population[j]->obj)) {
+					strenght[i]++;
+				} else if (MultiObjective::dominate (population[j]->obj,population[i]->obj)) {
+					strenght[j]++;
+				}
+
+			}
 		}
-	}
 
-	//calcula do raw-fitness R
-	for (int i=0; i < POPSIZE; i++) {
-		for (int j=(i+1); j < POPSIZE; j++) {
+		//calcula do raw-fitness R
+		for (int i=0; i < POPSIZE; i++) {
+			for (int j=(i+1); j < POPSIZE; j++) {
 
-			if (MultiObjective::dominate (population[i]->obj,population[j]->obj)) {
-				population[j]->fitness +=  strenght[i];
-			} else if (MultiObjective::dominate (population[j]->obj,population[i]->obj)) {
-				population[i]->fitness +=  strenght[j];
+				if (MultiObjective::dominate (population[i]->obj,population[j]->obj)) {
+					population[j]->fitness +=  strenght[i];
+				} else if (MultiObjective::dominate (population[j]->obj,population[i]->obj)) {
+					population[i]->fitness +=  strenght[j];
+				}
 			}
 		}
 	}
@@ -359,82 +820,123 @@ void Spea2::fitnessAssign () {
 
 }
 
-void Spea2::densityCalc () {
-	
-#ifdef DEBUG
-	printf ("\nFunction %s\n", __PRETTY_FUNCTION__ );
-#endif
-	
-	//limpando distance matrix
-	for (int i = 0; i < POPSIZE; i++) {
+template <class Problem>
+void Spea2<Problem>::constrainedFitness (std::vector<int> & strenght) {
 
-		population[i]->index = i;
-		
-		for (int j = 0; j < POPSIZE; j++) {
-			distance[i * POPSIZE + j].index = 0;
-			distance[i * POPSIZE + j].eDist = 0.0;
+	const int feasible = (int) m_feasible.size ();
+	const int infeasible = (int) m_infeasible.size ();
+
+	//strength: entre viáveis vale a dominância de Pareto e
+	//cada viável domina todos os inviáveis
+	for (int a=0; a < feasible; a++) {
+		int i = m_feasible[a];
+		strenght[i] += infeasible;
+		for (int b=(a+1); b < feasible; b++) {
+			int j = m_feasible[b];
 
+			if (MultiObjective::dominate (population[i]->obj,population[j]->obj)) {
+				strenght[i]++;
+			} else if (MultiObjective::dominate (population[j]->obj,population[i]->obj)) {
+				strenght[j]++;
+			}
 		}
 	}
-	
-	for (int i = 0; i < POPSIZE; i++) {
-		
-		for (int j = i; j < POPSIZE; j++) {
-			
-			if (i==j) continue;
-			
-			distance[i * POPSIZE + j].index = j;
-			distance[i * POPSIZE + j].eDist = MultiObjective::distanceCalc (population[i]->obj, population[j]->obj);
-			distance[j * POPSIZE + i].index = i;
-			distance[j * POPSIZE + i].eDist = distance[i * POPSIZE + j].eDist;
 
+	//inviáveis estão ordenados por violação: cada grupo de mesma
+	//violação domina todos os grupos seguintes
+	for (int k=0; k < infeasible; ) {
+		int end = k;
+		while (end < infeasible && population[m_infeasible[end]]->violation ==
+				population[m_infeasible[k]]->violation) end++;
+
+		for (int t=k; t < end; t++) strenght[m_infeasible[t]] = infeasible - end;
+		k = end;
+	}
+
+	//raw-fitness dos viáveis
+	int feasible_strength = 0;
+	for (int a=0; a < feasible; a++) {
+		int i = m_feasible[a];
+		feasible_strength += strenght[i];
+		for (int b=(a+1); b < feasible; b++) {
+			int j = m_feasible[b];
+
+			if (MultiObjective::dominate (population[i]->obj,population[j]->obj)) {
+				population[j]->fitness +=  strenght[i];
+			} else if (MultiObjective::dominate (population[j]->obj,population[i]->obj)) {
+				population[i]->fitness +=  strenght[j];
+			}
 		}
-	}	
-	
+	}
 
-	#ifdef DEBUG__
+	//raw-fitness dos inviáveis: todos os viáveis e os inviáveis de
+	//violação menor os dominam
+	int smaller_strength = 0;
+	for (int k=0; k < infeasible; ) {
+		int end = k;
+		while (end < infeasible && population[m_infeasible[end]]->violation ==
+				population[m_infeasible[k]]->violation) end++;
 
-	for (int i=0; i < POPSIZE;++i) {
-		for (int j=0; j < POPSIZE;++j) {
-			cout << distance[i * POPSIZE + j].eDist << " ";
+		for (int t=k; t < end; t++) {
+			population[m_infeasible[t]]->fitness += feasible_strength + smaller_strength;
 		}
-		cout << endl;
+		for (int t=k; t < end; t++) {
+			smaller_strength += strenght[m_infeasible[t]];
+		}
+		k = end;
 	}
-	#endif
 
-	//sorting the list of k-th nearest neighbor
+}
+
+template <class Problem>
+void Spea2<Problem>::densityCalc () {
+	
+#ifdef DEBUG
+	printf ("\nFunction %s\n", __PRETTY_FUNCTION__ );
+#endif
+
+	Profiler::Section section (m_profiler, Profiler::DENSITY, all_pop);
+	
 	for (int i = 0; i < POPSIZE; i++) {
-		sort (distance.begin() + (POPSIZE*i), distance.begin () + (POPSIZE*(i+1)), compare);
+		population[i]->index = i;
 	}
 
-	#ifdef DEBUG__
-	cout << endl;
-	for (int i=0; i < POPSIZE;++i) {
-		for (int j=0; j < POPSIZE;++j) {
-			cout << distance[i * POPSIZE + j].eDist << " ";
-		}
-		cout << endl;
+	//ocupação da célula de cada indivíduo na grade
+	if (m_use_grid) {
+		m_grid.load (population, POPSIZE);
+		return;
 	}
 
+	//quadrado da distância ao k-ésimo vizinho de cada indivíduo
+	m_distances.load (population, POPSIZE, m_normalize ? &m_bounds : NULL);
+	m_distances.kthNearest (kth, m_kth);
+
+	#ifdef DEBUG__
 	for (int i=0; i < POPSIZE;++i) {
 		cout << "Edit: " << getDensity(i) << endl;
 	}
-
 	#endif
 
 }
 
-double Spea2::getDensity (int i) {
+template <class Problem>
+double Spea2<Problem>::getDensity (int i) {
+	//grade: cresce com a ocupação da célula, sempre menor que 1
+	if (m_use_grid) return 1.0 - 1.0 / (m_grid.occupancy (i) + 1);
+
 	//modifiquei, troquei all_pop por POPSIZE
-	return (double)(1/(distance[i * POPSIZE + kth].eDist + 2));
+	return (double)(1/(sqrt (m_kth[i]) + 2));
 }
 
-void Spea2::environmentSelection () {
+template <class Problem>
+void Spea2<Problem>::environmentSelection () {
 	
 #ifdef DEBUG
 	printf ("\nFunction %s\n", __PRETTY_FUNCTION__ );
 #endif
 
+	Profiler::Section section (m_profiler, Profiler::SELECTION, all_pop);
+
 	int count = all_pop - 1;
 	int in_archive = 0;
 	for (int i = (POPSIZE - 1); i >= 0; --i) {
@@ -457,7 +959,30 @@ void Spea2::environmentSelection () {
 	#endif
 }
 
-void Spea2::truncation2(int arc_size) {
+template <class Problem>
+bool Spea2<Problem>::confirm () {
+
+	m_predicted.clear ();
+	for (int i = (all_pop - ARCSIZE); i < all_pop; ++i) {
+		if (population[i]->predicted) m_predicted.push_back (population[i]);
+	}
+	if (m_predicted.empty ()) return false;
+
+	Profiler::Section section (m_profiler, Profiler::EVALUATION, (int) m_predicted.size ());
+
+	for (unsigned i = 0; i < m_predicted.size (); ++i) m_bounds.erase (m_predicted[i]);
+	int confirmed = Screening::confirm (m_problem, &m_predicted[0], (int) m_predicted.size ());
+	for (unsigned i = 0; i < m_predicted.size (); ++i) m_bounds.insert (m_predicted[i]);
+
+	if (confirmed == 0) return false;
+
+	//fitnessAssign acumula sobre o fitness zerado
+	for (int i = 0; i < all_pop; ++i) population[i]->fitness = 0.0;
+	return true;
+}
+
+template <class Problem>
+void Spea2<Problem>::truncation2(int arc_size) {
 
 #ifdef DEBUG
 	printf ("\nFunction %s\n", __PRETTY_FUNCTION__ );
@@ -465,7 +990,8 @@ void Spea2::truncation2(int arc_size) {
 
 	if (arc_size < ARCSIZE) {
 
-		sort(population,population+(all_pop-ARCSIZE),compareByFitness);
+		//estável: empates de fitness mantêm a ordem da população
+		std::stable_sort (population, population+(all_pop-ARCSIZE), compareByFitness<Individual>);
 		for (int i=0; i < (all_pop-ARCSIZE); i++) {
 			if (population[i]->fitness > 1.0) {
 
@@ -478,29 +1004,23 @@ void Spea2::truncation2(int arc_size) {
 	} else {
 
 		int beginArch = all_pop - arc_size;
-		while (arc_size > ARCSIZE) {
-
-			int closest = beginArch;
-			double min_dist = numeric_limits<double>::max();
-
-			for (int i=beginArch; i < all_pop; i++) {
 
-				for (int j=i; j < all_pop; j++) {
-
-					if (i==j) continue;
+		if (m_use_grid) {
+			gridTruncation (beginArch, arc_size);
+			return;
+		}
 
-					double dist = MultiObjective::distanceCalc(
-									population[i]->obj,population[j]->obj);
+		//remove o primeiro indivíduo do par mais próximo até o arquivo
+		//ter ARCSIZE indivíduos; os demais mantêm a ordem relativa
+		m_distances.load (population + beginArch, arc_size, m_normalize ? &m_bounds : NULL);
+		m_distances.beginTruncation ();
 
-					if (dist < min_dist) {
-						min_dist = dist;
-						closest = i;
-					}
+		while (arc_size > ARCSIZE) {
 
-				} //end for j
-			}// end for i
+			int closest = m_distances.closest ();
 
-			removal(beginArch,closest);
+			removal(beginArch, beginArch + m_distances.position (closest));
+			m_distances.remove (closest);
 			beginArch++;
 			--arc_size;
 		}
@@ -509,147 +1029,221 @@ void Spea2::truncation2(int arc_size) {
 
 }
 
-//remove index by replace it by all individuals before it
-void Spea2::removal (int beginArch , int index) {
-	
-	for (int i = index; i > beginArch; --i) {		
-		changePos (i,i-1);
+template <class Problem>
+void Spea2<Problem>::gridTruncation (int beginArch, int arc_size) {
+
+	m_grid.load (population + beginArch, arc_size);
+	m_grid.truncate (arc_size - ARCSIZE, m_removed);
+
+	//retirados no início, mantidos em seguida, ambos na ordem original
+	m_kept.clear ();
+	int next = beginArch;
+	for (int i=0; i < arc_size; i++) {
+		if (m_removed[i]) population[next++] = population[beginArch + i];
+		else m_kept.push_back (population[beginArch + i]);
 	}
+	std::copy (m_kept.begin (), m_kept.end (), population + next);
+}
+
+//remove index by replace it by all individuals before it
+template <class Problem>
+void Spea2<Problem>::removal (int beginArch , int index) {
+
+	//desloca os indivíduos [beginArch, index) uma posição à frente
+	std::rotate (population + beginArch, population + index, population + index + 1);
 }
 
 //change pos of idx_i and idx_j
 //the first parameter indicates de new position
 //the second paramater indicates the old positions
-//it algo does the following
-//put change idx_i to idx_j position
-void Spea2::changePos (int idx_i, int idx_j) {
-
-	if (idx_i == idx_j) return;
-	
-	GenericIndividual * pointer = new GenericIndividual(false);
-	pointer->assign (population[idx_i]);
-	int index = population[idx_j]->index;
-	
-	if (population[idx_i]->assign (population[idx_j])) {
-		
-		population[idx_i]->index = index; //update the index of ind in archive
-		
-		if (population[idx_j]->assign(pointer)) {
-			population[idx_j]->index = pointer->index;
+template <class Problem>
+void Spea2<Problem>::changePos (int idx_i, int idx_j) {
 
-		}
-	}
-	
-	delete pointer;
-	
+	//troca apenas os ponteiros: o índice e o genótipo acompanham o indivíduo
+	std::swap (population[idx_i], population[idx_j]);
 }
 
 //here you can put your way to perform recombination
-void Spea2::recombination () {
+template <class Problem>
+void Spea2<Problem>::recombination () {
 	
 #ifdef DEBUG
 	printf ("\nFunction %s\n", __PRETTY_FUNCTION__ );
 #endif
+
+	Profiler::Section section (m_profiler, Profiler::VARIATION, all_pop - ARCSIZE);
 	
-	for (int i=0; i < (all_pop - ARCSIZE); i++) {
-		
-		GenericIndividual * ind = new GenericIndividual(false);
-		int _p1 = binaryTournament();
-		int _p2 = binaryTournament();
-		while (_p1 == _p2 ) _p2 = binaryTournament();
+	int offspring = all_pop - ARCSIZE;
+	selection (offspring);
 
-		GenericIndividual * p1 = population[_p1];
-		GenericIndividual * p2 = population[_p2];
-		
-		int prob = rand () % 10 + 1;
+	//os filhos são gerados diretamente nas posições da população
+	Variation::recombine (m_problem, &m_parents1[0], &m_parents2[0], population,
+			offspring, m_prob_cross, m_prob_mut, m_random);
 
-		if ( ((double)prob/10) <= m_prob_cross ) {
+	for (int i=0; i < offspring; i++) {
+		population[i]->index = i;
+		population[i]->fitness = 0.0;
+	}
 
-			//do something like crossover
+	evaluate (0, all_pop - ARCSIZE);
 
-		} else {
+	if (m_local != NULL) refine ();
 
-			//do something else
+	for (int i=(all_pop - ARCSIZE); i< all_pop; ++i) {
+		population[i]->fitness = 0.0;
+	}
 
-		}
+}
 
-		ind->index = i;
-		ind->obj[0] = ind->mpp_ind.getObjective(0);
-		ind->obj[1] = ind->mpp_ind.getObjective(1);
-		population[i]->assign (ind);
+template <class Problem>
+void Spea2<Problem>::refine () {
+
+	//as soluções da busca local já avaliadas ocupam o fim da prole
+	int offspring = all_pop - ARCSIZE;
+	int size = m_local->collect (m_local->limit (offspring));
+	for (int i=0; i < size; i++) {
+		Individual * target = population[offspring - 1 - i];
+		m_bounds.erase (target);
+		m_local->assign (i, target);
+		m_bounds.insert (target);
+	}
 
-		delete ind;
+	//o fitness do arquivo ainda é o da seleção ambiental anterior
+	for (int i=offspring; i < all_pop; i++) {
+		if (population[i]->fitness < 1.0 && !population[i]->predicted) m_local->submit (population[i]);
 	}
+}
 
-	for (int i=(all_pop - ARCSIZE); i< all_pop; ++i) {
-		population[i]->fitness = 0.0;
+template <class Problem>
+void Spea2<Problem>::selection (int offspring) {
+
+	//o arquivo ocupa as posições [all_pop - ARCSIZE, all_pop)
+	Individual ** archive = population + (all_pop - ARCSIZE);
+
+	m_keys.resize (ARCSIZE);
+	for (int i=0; i < ARCSIZE; i++) {
+		m_keys[i] = Selection::fitnessKey (archive[i]->fitness);
 	}
 
+	m_first.resize (offspring);
+	m_second.resize (offspring);
+	m_tournament.select (&m_keys[0], ARCSIZE, &m_first[0], &m_second[0], offspring, m_random);
+
+	m_parents1.resize (offspring);
+	m_parents2.resize (offspring);
+	for (int i=0; i < offspring; i++) {
+		m_parents1[i] = archive[m_first[i]];
+		m_parents2[i] = archive[m_second[i]];
+	}
 }
 
-int Spea2::binaryTournament  () {
+template <class Problem>
+void Spea2<Problem>::repair () { 
 
-	int ind1 = rand () % ARCSIZE + (all_pop - ARCSIZE);
-	int ind2 = rand () % ARCSIZE + (all_pop - ARCSIZE);
-	while (ind1 == ind2) ind2 = rand () % ARCSIZE + (all_pop - ARCSIZE);
+}
 
-	return (population[ind1]->fitness < population[ind2]->fitness ? ind1 : ind2);
+template <class Problem>
+void Spea2<Problem>::evaluate (int begin, int end) {
 
-}
+	Profiler::Section section (m_profiler, Profiler::EVALUATION, end - begin);
+
+	//com a população completa os indivíduos avaliados substituem
+	//indivíduos descartados, que deixam os limites dos objetivos
+	bool replace = m_bounds.size () == all_pop;
+	for (int i = begin; replace && i < end; ++i) {
+		m_bounds.erase (population[i]);
+	}
 
-void Spea2::repair () { 
+	m_problem.evaluate (population + begin, end - begin);
 
+	for (int i = begin; i < end; ++i) {
+		m_bounds.insert (population[i]);
+	}
 }
 
 
-void Spea2::printPop () {
+template <class Problem>
+void Spea2<Problem>::printPop () {
 	
-	//printf("Current Population\n");
-	for (int i=0; i < all_pop - ARCSIZE; i++) {
-		//printf ("Index: %d  fitness: %f \t",
-				//population[i]->index,
-				//population[i]->fitness);
-		double obj1 = population[i]->mpp_ind.getObjective(0);
-		double obj2 = population[i]->mpp_ind.getObjective(1);
-		printf ("%f %f\n",obj1, obj2);
-	}
+	char * out = Output::formatPopulation (m_text, population, 0, all_pop - ARCSIZE, false);
+	fwrite (m_text.data (), 1, out - m_text.data (), stdout);
 }
 
-void Spea2::printAsPisa () {
+template <class Problem>
+void Spea2<Problem>::printAsPisa () {
 	for (int i=all_pop - ARCSIZE; i < all_pop; i++) {
 		printf ("Index: %d  fitness: %f \t",
 					population[i]->index,
 					population[i]->fitness);
-		double obj1 = population[i]->obj[0];
-		double obj2 = population[i]->obj[1];
-		printf ("%f %f\n",obj1, obj2);
+		char * out = Output::formatPopulation (m_text, population, i, i + 1, false);
+		fwrite (m_text.data (), 1, out - m_text.data (), stdout);
 	}
 	printf ("\n");
 }
 
-void Spea2::printArc () {
+template <class Problem>
+void Spea2<Problem>::printArc () {
+
+	char * out = Output::formatPopulation (m_text, population, all_pop - ARCSIZE, all_pop, false);
+	fwrite (m_text.data (), 1, out - m_text.data (), stdout);
+}
 
+template <class Problem>
+void Spea2<Problem>::printArc(std::fstream& file) {
+
+	char * out = Output::formatPopulation (m_text, population, all_pop - ARCSIZE, all_pop, true);
+	*out++ = '\n';
+	file.write (m_text.data (), out - m_text.data ());
+
+}
+
+template <class Problem>
+void Spea2<Problem>::printArc(ResultWriter & writer) {
+
+	RunConfig::Scope scope (m_config);
+
+	ResultWriter::Block * block = writer.acquire (gen);
 	for (int i=all_pop - ARCSIZE; i < all_pop; i++) {
-		//printf ("Index: %d  fitness: %f \t",
-				//population[i]->index,
-				//population[i]->fitness);
-		double obj1 = population[i]->mpp_ind.getObjective(0);
-		double obj2 = population[i]->mpp_ind.getObjective(1);
-		printf ("%f %f\n",obj1, obj2);
+		if ( population[i]->fitness < 1.0 && !population[i]->predicted) {
+			block->add (population[i]->obj);
+		}
 	}
+	writer.push (block);
+
 }
 
-void Spea2::printArc(std::fstream& file) {
-	for (int i=all_pop - ARCSIZE; i < all_pop; i++) {
+template <class Problem>
+void Spea2<Problem>::setTermination (const Termination & termination) {
+	m_termination = termination;
+}
 
-		if ( population[i]->fitness < 1.0) {
-			double obj1 = population[i]->obj[0];
-			double obj2 = population[i]->obj[1];
-			file << obj1 << " " << obj2 << endl;
+template <class Problem>
+bool Spea2<Problem>::finished () {
+
+	Profiler::Section section (m_profiler, Profiler::OUTPUT);
+
+	int rows = nondominated (m_front, &m_front_violation);
+	m_snapshot.publish (gen, m_front, rows);
+	if (m_archive != NULL) m_archive->insert (m_front.data (), rows, m_front_violation.data ());
+
+	return m_termination.active () && m_termination.stop (m_front.data (), rows);
+}
+
+template <class Problem>
+int Spea2<Problem>::nondominated(std::vector<double> & values, std::vector<double> * violation) {
+
+	RunConfig::Scope scope (m_config);
+
+	values.clear ();
+	if (violation != NULL) violation->clear ();
+	for (int i=all_pop - ARCSIZE; i < all_pop; i++) {
+		if ( population[i]->fitness < 1.0 && !population[i]->predicted) {
+			values.insert (values.end (), population[i]->obj,
+					population[i]->obj + Info::OBJECTIVES);
+			if (violation != NULL) violation->push_back (population[i]->violation);
 		}
 	}
-	file << endl;
-
+	return (int) (values.size () / Info::OBJECTIVES);
 }
 
 #endif
@@ -0,0 +1,536 @@
+#ifndef _SURROGATE_H_
+#define _SURROGATE_H_
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+
+#include "generic_individual.h"
+#include "multiobjective.h"
+#include "random.h"
+#include "variation.h"
+
+/**
+ * Modelo substituto (surrogate) dos objetivos do problema.
+ *
+ * O modelo é treinado com os indivíduos avaliados de verdade: cada
+ * ponto de treino é um vetor de características (dim reais) e o seu
+ * alvo, os objetivos seguidos da violação das restrições. São mantidos
+ * no máximo capacity pontos; quando o modelo está cheio o ponto mais
+ * antigo é substituído.
+ *
+ * Dois modelos estão disponíveis:
+ *
+ *  - KNN: média dos alvos dos k vizinhos mais próximos ponderada pelo
+ *    inverso da distância. Treino O(1) por ponto;
+ *  - RBF: interpolação com funções de base radial gaussianas sobre
+ *    todos os pontos. O ajuste resolve um sistema capacity x capacity
+ *    (Cholesky, O(capacity^3)) a cada lote em que o modelo muda.
+ *
+ * Em ambos os modelos a dispersão de cada alvo entre os k vizinhos mais
+ * próximos é utilizada como estimativa da incerteza da predição.
+ *
+ * @see ScreenedProblem
+ * @date 18/10/2026
+ */
+class SurrogateModel {
+
+public:
+
+	enum Model {KNN, RBF};
+
+	/**
+	 * @param int dimensão do vetor de características
+	 * @param int tamanho do alvo (objetivos + violação)
+	 * @param Model
+	 * @param int quantidade máxima de pontos de treino
+	 * @param int quantidade de vizinhos
+	 */
+	SurrogateModel (int dim, int targets, Model model = KNN, int capacity = 256, int k = 5)
+		: m_dim (dim), m_targets (targets), m_model (model), m_capacity (capacity),
+		  m_k (k), m_size (0), m_next (0), m_dirty (false), m_width (1.0)
+	{
+		m_x.resize ((size_t) capacity * dim);
+		m_y.resize ((size_t) capacity * targets);
+	}
+
+	int size () const { return m_size; }
+	int dimension () const { return m_dim; }
+
+	/**
+	 * O modelo só é utilizado depois de possuir pontos suficientes.
+	 */
+	bool ready () const {
+		return m_size >= std::min (m_capacity, std::max (2 * m_k, 10));
+	}
+
+	/**
+	 * Adiciona um ponto de treino (x com dim reais, y com targets reais).
+	 */
+	void add (const double * x, const double * y) {
+		memcpy (&m_x[(size_t) m_next * m_dim], x, m_dim * sizeof (double));
+		memcpy (&m_y[(size_t) m_next * m_targets], y, m_targets * sizeof (double));
+		m_next = (m_next + 1) % m_capacity;
+		if (m_size < m_capacity) m_size++;
+		m_dirty = true;
+	}
+
+	/**
+	 * Ajusta o modelo aos pontos atuais. Para o KNN não há ajuste.
+	 */
+	void train () {
+
+		if (!m_dirty || m_model != RBF || m_size == 0) return;
+		m_dirty = false;
+
+		const int n = m_size;
+
+		//largura do kernel: distância média ao vizinho mais próximo
+		double mean = 0.0;
+		for (int i=0; i < n; i++) {
+			double nearest = HUGE_VAL;
+			for (int j=0; j < n; j++) {
+				if (i != j) nearest = std::min (nearest, squared (&m_x[(size_t) i * m_dim], &m_x[(size_t) j * m_dim]));
+			}
+			if (n > 1) mean += std::sqrt (nearest);
+		}
+		m_width = n > 1 ? std::max (2.0 * mean / n, 1e-12) : 1.0;
+
+		//matriz do kernel com regularização, decomposta por Cholesky
+		m_chol.assign ((size_t) n * n, 0.0);
+		for (int i=0; i < n; i++) {
+			for (int j=0; j <= i; j++) {
+				double value = kernel (squared (&m_x[(size_t) i * m_dim], &m_x[(size_t) j * m_dim]));
+				if (i == j) value += 1e-8;
+				m_chol[(size_t) i * n + j] = value;
+			}
+		}
+
+		for (int j=0; j < n; j++) {
+			double * row = &m_chol[(size_t) j * n];
+			double d = row[j];
+			for (int p=0; p < j; p++) d -= row[p] * row[p];
+			d = std::sqrt (std::max (d, 1e-12));
+			row[j] = d;
+			for (int i=j+1; i < n; i++) {
+				double * other = &m_chol[(size_t) i * n];
+				double s = other[j];
+				for (int p=0; p < j; p++) s -= other[p] * row[p];
+				other[j] = s / d;
+			}
+		}
+
+		//pesos: resolve L L^T w = y - média para cada alvo
+		m_weights.assign ((size_t) n * m_targets, 0.0);
+		m_mean.assign (m_targets, 0.0);
+		std::vector<double> z (n);
+		for (int t=0; t < m_targets; t++) {
+			for (int i=0; i < n; i++) m_mean[t] += m_y[(size_t) i * m_targets + t];
+			m_mean[t] /= n;
+
+			for (int i=0; i < n; i++) {
+				double s = m_y[(size_t) i * m_targets + t] - m_mean[t];
+				for (int p=0; p < i; p++) s -= m_chol[(size_t) i * n + p] * z[p];
+				z[i] = s / m_chol[(size_t) i * n + i];
+			}
+			for (int i=n-1; i >= 0; i--) {
+				double s = z[i];
+				for (int p=i+1; p < n; p++) s -= m_chol[(size_t) p * n + i] * m_weights[(size_t) p * m_targets + t];
+				m_weights[(size_t) i * m_targets + t] = s / m_chol[(size_t) i * n + i];
+			}
+		}
+	}
+
+	/**
+	 * Prediz o alvo de x em y e a dispersão de cada alvo em spread.
+	 */
+	void predict (const double * x, double * y, double * spread) {
+
+		const int n = m_size;
+		const int k = std::min (m_k, n);
+
+		m_distance.resize (n);
+		m_order.resize (n);
+		for (int i=0; i < n; i++) {
+			m_distance[i] = squared (x, &m_x[(size_t) i * m_dim]);
+			m_order[i] = i;
+		}
+		std::partial_sort (m_order.begin (), m_order.begin () + k, m_order.end (),
+			[this] (int a, int b) {
+				return m_distance[a] < m_distance[b] || (m_distance[a] == m_distance[b] && a < b);
+			});
+
+		for (int t=0; t < m_targets; t++) {
+			double mean = 0.0, square = 0.0;
+			for (int c=0; c < k; c++) {
+				double value = m_y[(size_t) m_order[c] * m_targets + t];
+				mean += value;
+				square += value * value;
+			}
+			mean /= k;
+			spread[t] = std::sqrt (std::max (square / k - mean * mean, 0.0));
+		}
+
+		if (m_model == RBF) {
+			train ();
+			for (int t=0; t < m_targets; t++) y[t] = m_mean[t];
+			for (int i=0; i < n; i++) {
+				double phi = kernel (m_distance[i]);
+				const double * w = &m_weights[(size_t) i * m_targets];
+				for (int t=0; t < m_targets; t++) y[t] += phi * w[t];
+			}
+			return;
+		}
+
+		//KNN ponderado pelo inverso da distância
+		double total = 0.0;
+		for (int t=0; t < m_targets; t++) y[t] = 0.0;
+		for (int c=0; c < k; c++) {
+			int i = m_order[c];
+			if (m_distance[i] == 0.0) {
+				memcpy (y, &m_y[(size_t) i * m_targets], m_targets * sizeof (double));
+				return;
+			}
+			double w = 1.0 / std::sqrt (m_distance[i]);
+			total += w;
+			for (int t=0; t < m_targets; t++) y[t] += w * m_y[(size_t) i * m_targets + t];
+		}
+		for (int t=0; t < m_targets; t++) y[t] /= total;
+	}
+
+private:
+
+	double squared (const double * a, const double * b) const {
+		double sum = 0.0;
+		for (int j=0; j < m_dim; j++) {
+			double d = a[j] - b[j];
+			sum += d * d;
+		}
+		return sum;
+	}
+
+	double kernel (double squared) const {
+		return std::exp (-squared / (m_width * m_width));
+	}
+
+	int m_dim;
+	int m_targets;
+	Model m_model;
+	int m_capacity;
+	int m_k;
+
+	int m_size;
+	int m_next;
+	bool m_dirty;
+	double m_width;
+
+	std::vector<double> m_x;
+	std::vector<double> m_y;
+	std::vector<double> m_chol;
+	std::vector<double> m_weights;
+	std::vector<double> m_mean;
+
+	std::vector<double> m_distance;
+	std::vector<int> m_order;
+};
+
+namespace Screening {
+
+	template <class Problem, class Individual, class = void>
+	struct has_confirm : std::false_type {};
+
+	template <class Problem, class Individual>
+	struct has_confirm<Problem, Individual, std::void_t<decltype (std::declval<Problem &> ().confirm (
+			std::declval<Individual **> (), 0))> >
+		: std::true_type {};
+
+	/**
+	 * Avalia de verdade os indivíduos preditos individuals[0, size)
+	 * antes que sobrevivam à seleção. Utiliza Problem::confirm quando
+	 * disponível (ScreenedProblem); caso contrário a marca é retirada e
+	 * o lote é entregue a Problem::evaluate.
+	 *
+	 * @return int quantidade de indivíduos que deixaram de ser preditos
+	 */
+	template <class Problem, class Individual>
+	int confirm (Problem & problem, Individual ** individuals, int size)
+	{
+		if constexpr (has_confirm<Problem, Individual>::value) {
+			problem.confirm (individuals, size);
+		} else {
+			for (int i=0; i < size; i++) individuals[i]->predicted = false;
+			problem.evaluate (individuals, size);
+		}
+
+		int confirmed = 0;
+		for (int i=0; i < size; i++) confirmed += !individuals[i]->predicted;
+		return confirmed;
+	}
+
+}
+
+/**
+ * Política de problema que adiciona uma etapa de pré-seleção por
+ * modelo substituto antes da avaliação, para problemas de avaliação
+ * cara. Assim como CachedProblem, é utilizada sem alterar os algoritmos:
+ *
+ *		MulticastProblem policy (Info::mproblem);
+ *		ScreenedProblem<MulticastProblem> problem (policy, 0.3, 16);
+ *		Nsga2<ScreenedProblem<MulticastProblem> > nsga2 (problem, 100, 500);
+ *
+ * O terceiro parâmetro é a dimensão das características (veja abaixo).
+ *
+ * A cada lote os objetivos de todos os indivíduos são preditos pelo
+ * modelo. Os indivíduos são ordenados pela quantidade de indivíduos do
+ * lote que os dominam na predição e apenas a fração fraction mais
+ * promissora é avaliada por Problem::evaluate. Os demais recebem os
+ * objetivos preditos acrescidos da dispersão dos vizinhos no sentido
+ * de piora de cada objetivo (estimativa pessimista), de modo que
+ * dificilmente ocupam o lugar de indivíduos avaliados, e são marcados
+ * como preditos (GenericIndividual::predicted). Os algoritmos não
+ * utilizam indivíduos preditos nos limites dos objetivos, e a busca
+ * local não os aceita como soluções melhoradas nem como sementes.
+ *
+ * Um indivíduo predito não sobrevive com objetivos preditos: os que
+ * seriam escolhidos pela seleção (Nsga2::nextPopulation,
+ * Spea2::environmentSelection) são avaliados por confirm e a seleção
+ * é refeita. Assim a pré-seleção evita apenas a avaliação dos
+ * indivíduos descartados, e as saídas contêm apenas avaliações reais.
+ *
+ * Enquanto o modelo não possui pontos suficientes todos os indivíduos
+ * são avaliados. O custo de treino por geração é limitado por capacity
+ * (tamanho do modelo) e por budget, a quantidade máxima de pontos novos
+ * incorporados ao modelo por lote.
+ *
+ * O genótipo é convertido em características por
+ * Problem::features (const genotype_type &, std::vector<double> &)
+ * ou, se genotype_type for std::vector<double>, diretamente.
+ *
+ * Com um cache de avaliações a ordem recomendada é
+ * ScreenedProblem<CachedProblem<Problem> >: a pré-seleção recebe o lote
+ * inteiro e o cache guarda apenas avaliações reais. Na ordem inversa,
+ * CachedProblem<ScreenedProblem<Problem> >, o cache não guarda os
+ * indivíduos preditos, mas a pré-seleção recebe apenas as faltas.
+ *
+ * O modelo não é salvo nos checkpoints: uma execução retomada treina
+ * um modelo novo. A marca de predição é salva.
+ */
+template <class Problem>
+class ScreenedProblem {
+
+public:
+	typedef typename Problem::genotype_type genotype_type;
+	typedef GenericIndividual<genotype_type> Individual;
+
+	/**
+	 * @param Problem
+	 * @param double fração do lote enviada para avaliação
+	 * @param int dimensão das características
+	 * @param Model
+	 * @param int quantidade máxima de pontos do modelo
+	 * @param int quantidade máxima de pontos novos por lote
+	 */
+	ScreenedProblem (Problem & problem, double fraction, int dim,
+					 SurrogateModel::Model model = SurrogateModel::KNN,
+					 int capacity = 256, int budget = 64)
+		: m_problem (problem), m_fraction (fraction), m_budget (budget),
+		  m_model (dim, Info::OBJECTIVES + 1, model, capacity),
+		  m_evaluated (0), m_saved (0)
+	{}
+
+	void create (genotype_type & genotype, Random & random) {
+		m_problem.create (genotype, random);
+	}
+
+	void crossover (const genotype_type & p1, const genotype_type & p2,
+					genotype_type & child, Random & random) {
+		m_problem.crossover (p1, p2, child, random);
+	}
+
+	void mutation (genotype_type & genotype, Random & random) {
+		m_problem.mutation (genotype, random);
+	}
+
+	void recombine (Individual ** p1, Individual ** p2, Individual ** children,
+					int size, double p_cross, double p_mut, Random & random) {
+		Variation::recombine (m_problem, p1, p2, children, size, p_cross, p_mut, random);
+	}
+
+	void neighbour (const genotype_type & source, genotype_type & target, Random & random) {
+		Variation::neighbour (m_problem, source, target, random);
+	}
+
+	void evaluate (Individual ** individuals, int size) {
+
+		const int M = Info::OBJECTIVES;
+
+		if (!m_model.ready ()) {
+			for (int i=0; i < size; i++) individuals[i]->predicted = false;
+			m_problem.evaluate (individuals, size);
+			m_evaluated += size;
+			learn (individuals, size);
+			return;
+		}
+
+		//predição dos objetivos de todo o lote
+		m_predicted.resize ((size_t) size * (M + 1));
+		m_spread.resize (M + 1);
+		for (int i=0; i < size; i++) {
+			features (individuals[i]->genotype);
+			double * y = &m_predicted[(size_t) i * (M + 1)];
+			m_model.predict (&m_features[0], y, &m_spread[0]);
+			for (int j=0; j < M; j++) y[j] += Info::objconf[j] * m_spread[j];
+			y[M] = std::max (y[M], 0.0);
+		}
+
+		//indivíduos dominados por menos indivíduos do lote primeiro
+		m_dominated.assign (size, 0);
+		for (int i=0; i < size; i++) {
+			double * a = &m_predicted[(size_t) i * (M + 1)];
+			for (int j=0; j < size; j++) {
+				if (i == j) continue;
+				double * b = &m_predicted[(size_t) j * (M + 1)];
+				if (MultiObjective::dominate (b, a, b[M], a[M]) == MultiObjective::DOMINATED &&
+					!MultiObjective::equals (a, b)) {
+					m_dominated[i]++;
+				}
+			}
+		}
+
+		m_order.resize (size);
+		for (int i=0; i < size; i++) m_order[i] = i;
+		std::stable_sort (m_order.begin (), m_order.end (),
+			[this] (int a, int b) { return m_dominated[a] < m_dominated[b]; });
+
+		int selected = (int) std::ceil (m_fraction * size);
+		selected = std::max (1, std::min (size, selected));
+
+		m_pending.clear ();
+		for (int c=0; c < selected; c++) {
+			m_pending.push_back (individuals[m_order[c]]);
+			m_pending[c]->predicted = false;
+		}
+		m_problem.evaluate (&m_pending[0], selected);
+		learn (&m_pending[0], selected);
+
+		for (int c=selected; c < size; c++) {
+			Individual * ind = individuals[m_order[c]];
+			const double * y = &m_predicted[(size_t) m_order[c] * (M + 1)];
+			memcpy (ind->obj, y, M * sizeof (double));
+			ind->violation = y[M];
+			ind->predicted = true;
+		}
+
+		m_evaluated += selected;
+		m_saved += size - selected;
+	}
+
+	/**
+	 * Avalia por Problem::evaluate os indivíduos preditos do lote, que
+	 * deixam de ser preditos e passam a treinar o modelo.
+	 */
+	void confirm (Individual ** individuals, int size) {
+
+		m_pending.clear ();
+		for (int i=0; i < size; i++) {
+			if (!individuals[i]->predicted) continue;
+			individuals[i]->predicted = false;
+			m_pending.push_back (individuals[i]);
+		}
+		if (m_pending.empty ()) return;
+
+		int count = (int) m_pending.size ();
+		m_problem.evaluate (&m_pending[0], count);
+		learn (&m_pending[0], count);
+
+		//indivíduos retomados de um checkpoint não foram contados
+		m_evaluated += count;
+		m_saved -= std::min<uint64_t> (m_saved, count);
+	}
+
+	uint64_t hash (const genotype_type & genotype) {
+		return m_problem.hash (genotype);
+	}
+
+	void write (const genotype_type & genotype, std::vector<char> & buffer) {
+		m_problem.write (genotype, buffer);
+	}
+
+	void read (const char * data, size_t size, genotype_type & genotype) {
+		m_problem.read (data, size, genotype);
+	}
+
+	/**
+	 * Quantidade de avaliações realizadas e evitadas pela pré-seleção.
+	 */
+	uint64_t evaluated () const { return m_evaluated; }
+	uint64_t saved () const { return m_saved; }
+
+	void printStatistics () {
+		uint64_t total = m_evaluated + m_saved;
+		printf ("Surrogate: %llu evaluated %llu saved (%.1f%% saved) %d training points\n",
+				(unsigned long long) m_evaluated, (unsigned long long) m_saved,
+				total ? 100.0 * m_saved / total : 0.0, m_model.size ());
+	}
+
+private:
+
+	template <class P, class = void>
+	struct has_features : std::false_type {};
+
+	template <class P>
+	struct has_features<P, std::void_t<decltype (std::declval<P &> ().features (
+			std::declval<const genotype_type &> (), std::declval<std::vector<double> &> ()))> >
+		: std::true_type {};
+
+	void features (const genotype_type & genotype) {
+		if constexpr (has_features<Problem>::value) {
+			m_problem.features (genotype, m_features);
+		} else {
+			static_assert (std::is_same<genotype_type, std::vector<double> >::value,
+					"ScreenedProblem: Problem::features is required for this genotype");
+			m_features = genotype;
+		}
+		m_features.resize (m_model.dimension ());
+	}
+
+	/**
+	 * Incorpora ao modelo até budget indivíduos avaliados.
+	 */
+	void learn (Individual ** individuals, int size) {
+
+		const int M = Info::OBJECTIVES;
+		m_target.resize (M + 1);
+
+		int count = std::min (size, m_budget);
+		for (int i=0; i < count; i++) {
+			features (individuals[i]->genotype);
+			memcpy (&m_target[0], individuals[i]->obj, M * sizeof (double));
+			m_target[M] = individuals[i]->violation;
+			m_model.add (&m_features[0], &m_target[0]);
+		}
+		m_model.train ();
+	}
+
+	Problem m_problem;
+	double m_fraction;
+	int m_budget;
+	SurrogateModel m_model;
+
+	uint64_t m_evaluated;
+	uint64_t m_saved;
+
+	std::vector<double> m_features;
+	std::vector<double> m_target;
+	std::vector<double> m_predicted;
+	std::vector<double> m_spread;
+	std::vector<int> m_dominated;
+	std::vector<int> m_order;
+	std::vector<Individual *> m_pending;
+};
+
+#endif
@@ -0,0 +1,305 @@
+#ifndef _TERMINATION_H_
+#define _TERMINATION_H_
+
+#include <stdint.h>
+#include <cmath>
+#include <cstring>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <chrono>
+#include <algorithm>
+
+#include "problem_info.h"
+#include "random.h"
+
+/**
+ * Critérios de parada dos algoritmos, além do número máximo de
+ * gerações:
+ *
+ *  - tempo: a execução para na primeira geração concluída depois de
+ *    seconds segundos de relógio (a verificação é feita ao fim de cada
+ *    geração);
+ *  - estagnação: a execução para quando a fronteira não muda por window
+ *    gerações seguidas. A mudança é medida pelo hipervolume (variação
+ *    relativa maior que tolerance) ou pelo conjunto de vetores da
+ *    fronteira de rank 0.
+ *
+ * O hipervolume é exato para dois objetivos. Com mais objetivos é
+ * estimado por Monte Carlo com uma amostra fixa, o que basta para
+ * detectar estagnação. O ponto de referência e a caixa de amostragem
+ * são definidos pela primeira fronteira recebida, com uma margem de
+ * 10%; pontos fora da caixa são ignorados.
+ *
+ *		Termination termination;
+ *		termination.setTimeLimit (3600);
+ *		termination.setStall (50, Termination::HYPERVOLUME, 1e-6);
+ *		nsga2.setTermination (termination);
+ *
+ * O estado não é salvo nos checkpoints: o relógio e a janela recomeçam
+ * em uma execução retomada.
+ *
+ * @date 18/10/2026
+ */
+class Termination {
+
+public:
+
+	enum Criterion {HYPERVOLUME, MEMBERSHIP};
+	enum Reason {NONE, TIME, STALL};
+
+	Termination () : m_seconds (0.0), m_window (0), m_criterion (MEMBERSHIP),
+		m_tolerance (0.0), m_reason (NONE), m_stalled (0), m_last (0.0), m_first (true) {}
+
+	/**
+	 * Limite de tempo de relógio em segundos (zero desativa).
+	 */
+	void setTimeLimit (double seconds) { m_seconds = seconds; }
+
+	/**
+	 * Para após window gerações sem mudança na fronteira (zero desativa).
+	 */
+	void setStall (int window, Criterion criterion = MEMBERSHIP, double tolerance = 0.0) {
+		m_window = window;
+		m_criterion = criterion;
+		m_tolerance = tolerance;
+	}
+
+	bool active () const { return m_seconds > 0.0 || m_window > 0; }
+
+	/**
+	 * Inicia o relógio e descarta o histórico da fronteira.
+	 */
+	void start () {
+		m_start = std::chrono::steady_clock::now ();
+		m_reason = NONE;
+		m_stalled = 0;
+		m_first = true;
+	}
+
+	double elapsed () const {
+		return std::chrono::duration<double> (std::chrono::steady_clock::now () - m_start).count ();
+	}
+
+	/**
+	 * Recebe a fronteira de rank 0 ao fim de uma geração (rows vetores
+	 * de Info::OBJECTIVES objetivos) e retorna verdadeiro se a execução
+	 * deve parar.
+	 */
+	bool stop (const double * front, int rows) {
+
+		if (m_window > 0) {
+			double value = m_criterion == HYPERVOLUME ? hypervolume (front, rows) : membership (front, rows);
+
+			bool changed;
+			if (m_first) {
+				changed = true;
+			} else if (m_criterion == HYPERVOLUME) {
+				changed = std::fabs (value - m_last) > m_tolerance * std::max (std::fabs (m_last), 1e-300);
+			} else {
+				changed = value != m_last;
+			}
+
+			m_stalled = changed ? 0 : m_stalled + 1;
+			m_last = value;
+			m_first = false;
+
+			if (m_stalled >= m_window) {
+				m_reason = STALL;
+				return true;
+			}
+		}
+
+		if (m_seconds > 0.0 && elapsed () >= m_seconds) {
+			m_reason = TIME;
+			return true;
+		}
+
+		return false;
+	}
+
+	/**
+	 * Motivo da parada antecipada (NONE se a execução foi até a última
+	 * geração).
+	 */
+	Reason reason () const { return m_reason; }
+
+private:
+
+	/**
+	 * Hipervolume da fronteira com todos os objetivos convertidos para
+	 * minimização.
+	 */
+	double hypervolume (const double * front, int rows) {
+
+		const int M = Info::OBJECTIVES;
+
+		m_points.resize ((size_t) rows * M);
+		for (int i=0; i < rows; i++) {
+			for (int j=0; j < M; j++) {
+				m_points[(size_t) i * M + j] = front[(size_t) i * M + j] * Info::objconf[j];
+			}
+		}
+
+		if (m_first) {
+			m_lower.assign (M, HUGE_VAL);
+			m_reference.assign (M, -HUGE_VAL);
+			for (int i=0; i < rows; i++) {
+				for (int j=0; j < M; j++) {
+					m_lower[j] = std::min (m_lower[j], m_points[(size_t) i * M + j]);
+					m_reference[j] = std::max (m_reference[j], m_points[(size_t) i * M + j]);
+				}
+			}
+			for (int j=0; j < M; j++) {
+				double margin = 0.1 * std::max (m_reference[j] - m_lower[j], 1e-12);
+				m_lower[j] -= margin;
+				m_reference[j] += margin;
+			}
+			if (M > 2) sample ();
+		}
+
+		if (M == 2) return hypervolume2d (rows);
+
+		//Monte Carlo: fração das amostras dominadas por algum ponto
+		int dominated = 0;
+		const int samples = (int) (m_samples.size () / M);
+		for (int s=0; s < samples; s++) {
+			const double * x = &m_samples[(size_t) s * M];
+			for (int i=0; i < rows; i++) {
+				const double * p = &m_points[(size_t) i * M];
+				int j = 0;
+				while (j < M && p[j] <= x[j]) j++;
+				if (j == M) {
+					dominated++;
+					break;
+				}
+			}
+		}
+
+		double volume = 1.0;
+		for (int j=0; j < M; j++) volume *= m_reference[j] - m_lower[j];
+		return volume * dominated / samples;
+	}
+
+	double hypervolume2d (int rows) {
+
+		m_order.resize (rows);
+		for (int i=0; i < rows; i++) m_order[i] = i;
+		std::sort (m_order.begin (), m_order.end (), [this] (int a, int b) {
+			return m_points[2*a] < m_points[2*b] ||
+				(m_points[2*a] == m_points[2*b] && m_points[2*a + 1] < m_points[2*b + 1]);
+		});
+
+		double volume = 0.0;
+		double height = m_reference[1];
+		for (int k=0; k < rows; k++) {
+			double x = m_points[2 * m_order[k]];
+			double y = m_points[2 * m_order[k] + 1];
+			if (x >= m_reference[0] || y >= height) continue;
+			volume += (m_reference[0] - x) * (height - y);
+			height = y;
+		}
+		return volume;
+	}
+
+	void sample () {
+		const int M = Info::OBJECTIVES;
+		const int samples = 10000;
+		Random random (0x5eed);
+		m_samples.resize ((size_t) samples * M);
+		for (int s=0; s < samples; s++) {
+			for (int j=0; j < M; j++) {
+				m_samples[(size_t) s * M + j] = m_lower[j] + random.nextDouble () * (m_reference[j] - m_lower[j]);
+			}
+		}
+	}
+
+	/**
+	 * Assinatura do conjunto de vetores da fronteira, independente da
+	 * ordem dos vetores.
+	 */
+	double membership (const double * front, int rows) {
+
+		const int M = Info::OBJECTIVES;
+		uint64_t signature = (uint64_t) rows;
+		for (int i=0; i < rows; i++) {
+			uint64_t h = 0x9e3779b97f4a7c15ULL;
+			for (int j=0; j < M; j++) {
+				double value = front[(size_t) i * M + j];
+				if (value == 0.0) value = 0.0;
+				uint64_t bits;
+				memcpy (&bits, &value, sizeof (double));
+				h ^= bits;
+				h *= 0xff51afd7ed558ccdULL;
+				h ^= h >> 32;
+			}
+			signature += h;
+		}
+
+		//os 53 bits mais significativos cabem exatamente em um double
+		return (double) (signature >> 11);
+	}
+
+	double m_seconds;
+	int m_window;
+	Criterion m_criterion;
+	double m_tolerance;
+
+	Reason m_reason;
+	int m_stalled;
+	double m_last;
+	bool m_first;
+	std::chrono::steady_clock::time_point m_start;
+
+	std::vector<double> m_points;
+	std::vector<double> m_lower;
+	std::vector<double> m_reference;
+	std::vector<double> m_samples;
+	std::vector<int> m_order;
+};
+
+/**
+ * Cópia da fronteira não dominada publicada pelo algoritmo ao fim de
+ * cada geração. Pode ser lida por outra thread (monitoramento) enquanto
+ * a execução continua: a publicação troca um ponteiro compartilhado e a
+ * leitura apenas copia esse ponteiro, ambas sob um mutex.
+ */
+class Snapshot {
+
+public:
+
+	struct Front {
+		Front () : generation (0), rows (0) {}
+
+		int generation;
+		int rows;
+		std::vector<double> values;
+	};
+
+	/**
+	 * Publica a fronteira values (rows vetores) da geração generation.
+	 */
+	void publish (int generation, const std::vector<double> & values, int rows) {
+		std::shared_ptr<Front> front (new Front);
+		front->generation = generation;
+		front->rows = rows;
+		front->values = values;
+
+		std::lock_guard<std::mutex> lock (m_mutex);
+		m_front = front;
+	}
+
+	/**
+	 * Retorna a última fronteira publicada (NULL se nenhuma).
+	 */
+	std::shared_ptr<const Front> latest () const {
+		std::lock_guard<std::mutex> lock (m_mutex);
+		return m_front;
+	}
+
+private:
+	mutable std::mutex m_mutex;
+	std::shared_ptr<const Front> m_front;
+};
+
+#endif
@@ -0,0 +1,137 @@
+#ifndef _THREAD_POOL_H_
+#define _THREAD_POOL_H_
+
+#include <deque>
+#include <algorithm>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <functional>
+#include <condition_variable>
+
+/**
+ * Conjunto fixo de threads que executam tarefas de uma fila.
+ *
+ * As tarefas são funções sem parâmetros e sem retorno. wait()
+ * bloqueia até que todas as tarefas submetidas tenham terminado.
+ *
+ *		ThreadPool pool (8);
+ *		for (int i=0; i < 30; i++) pool.submit ([i] { ... });
+ *		pool.wait ();
+ *
+ * @date 18/10/2026
+ */
+class ThreadPool {
+
+public:
+
+	/**
+	 * Cria o conjunto com threads threads. Se threads for menor ou
+	 * igual a zero utiliza a quantidade de núcleos da máquina.
+	 */
+	ThreadPool (int threads = 0) : m_running (0), m_stop (false) {
+
+		if (threads <= 0) threads = std::thread::hardware_concurrency ();
+		if (threads <= 0) threads = 1;
+
+		for (int i=0; i < threads; i++) {
+			m_threads.push_back (std::thread (&ThreadPool::loop, this));
+		}
+	}
+
+	/**
+	 * Aguarda as tarefas pendentes e encerra as threads.
+	 */
+	~ThreadPool () {
+		wait ();
+		{
+			std::lock_guard<std::mutex> lock (m_mutex);
+			m_stop = true;
+		}
+		m_work.notify_all ();
+		for (unsigned i=0; i < m_threads.size (); i++) {
+			m_threads[i].join ();
+		}
+	}
+
+	int size () const {
+		return (int) m_threads.size ();
+	}
+
+	void submit (const std::function<void ()> & task) {
+		{
+			std::lock_guard<std::mutex> lock (m_mutex);
+			m_tasks.push_back (task);
+		}
+		m_work.notify_one ();
+	}
+
+	/**
+	 * Bloqueia até que a fila esteja vazia e nenhuma tarefa esteja
+	 * em execução. São aguardadas todas as tarefas do pool, inclusive
+	 * as submetidas por outros chamadores: um pool compartilhado
+	 * sincroniza os seus usuários, e uma tarefa que chama wait no
+	 * próprio pool nunca termina.
+	 */
+	void wait () {
+		std::unique_lock<std::mutex> lock (m_mutex);
+		while (!m_tasks.empty () || m_running > 0) m_done.wait (lock);
+	}
+
+	/**
+	 * Executa body (i) para i em [begin, end), dividindo o intervalo
+	 * em blocos contíguos entre as threads, e aguarda o término.
+	 */
+	void parallelFor (int begin, int end, const std::function<void (int)> & body) {
+
+		int n = end - begin;
+		if (n <= 0) return;
+
+		int chunks = std::min (n, size ());
+		for (int c=0; c < chunks; c++) {
+			int b = begin + (int) ((long long) n * c / chunks);
+			int e = begin + (int) ((long long) n * (c + 1) / chunks);
+			submit ([b, e, &body] {
+				for (int i=b; i < e; i++) body (i);
+			});
+		}
+		wait ();
+	}
+
+private:
+	void loop () {
+
+		while (true) {
+
+			std::function<void ()> task;
+			{
+				std::unique_lock<std::mutex> lock (m_mutex);
+				while (m_tasks.empty () && !m_stop) m_work.wait (lock);
+				if (m_tasks.empty ()) return;
+
+				task = m_tasks.front ();
+				m_tasks.pop_front ();
+				m_running++;
+			}
+
+			task ();
+
+			{
+				std::lock_guard<std::mutex> lock (m_mutex);
+				m_running--;
+			}
+			m_done.notify_all ();
+		}
+	}
+
+	std::vector<std::thread> m_threads;
+	std::deque<std::function<void ()> > m_tasks;
+	int m_running;
+	bool m_stop;
+
+	std::mutex m_mutex;
+	std::condition_variable m_work;
+	std::condition_variable m_done;
+};
+
+#endif
@@ -0,0 +1,656 @@
+/**
+ * Testes diferenciais e de propriedades dos motores de dominância,
+ * ordenação, densidade, arquivo e filtro.
+ *
+ * Uso:
+ *
+ *		engine_check [-iterations n] [-seed s] [-n vetores] [-m objetivos] [-t threads]
+ *
+ * Cada iteração gera um conjunto de até n vetores, aleatório ou
+ * adversário (uniforme, fronteira, empates, duplicatas, NaN e infinitos,
+ * 16 a 64 objetivos), com sentidos de otimização aleatórios, e compara
+ * cada motor com uma implementação de força bruta:
+ *
+ *  - MultiObjective::dominate com a dominância fraca;
+ *  - DominanceSort (count e nondominated, serial e com t threads);
+ *  - FrontMerge::nondominated (uma cópia de cada vetor, sem NaN);
+ *  - EpsilonArchive: todo vetor oferecido é coberto por uma caixa do
+ *    arquivo e as caixas do arquivo são não dominadas entre si;
+ *  - GridDensity: ocupação das células e truncamento guloso;
+ *  - DistanceEngine (double e float): k-ésimo vizinho e truncamento;
+ *  - Reproducible::sum com e sem threads.
+ *
+ * O DistanceEngine não define distâncias com NaN ou infinitos: nele os
+ * valores não finitos são trocados por 0.5.
+ *
+ * Cada falha é descrita com a semente do caso; engine_check -seed
+ * semente -iterations 1 repete apenas aquele caso. O código de saída é
+ * diferente de zero se houver falhas. O leitor de fronteiras texto é
+ * testado por tools/fuzz_front_text.cpp.
+ *
+ * Compilação: g++ -std=c++17 -O2 -I.. engine_check.cpp -o engine_check -lpthread
+ */
+#include <stdint.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdarg>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <map>
+#include <limits>
+#include <algorithm>
+
+#include "../random.h"
+#include "../thread_pool.h"
+#include "../multiobjective.h"
+#include "../dominance_sort.h"
+#include "../front_merge.h"
+#include "../epsilon_archive.h"
+#include "../grid_density.h"
+#include "../distance_engine.h"
+#include "../reproducible.h"
+
+//tipos de conjunto gerados
+enum Kind {UNIFORM, FRONT, TIES, DUPLICATES, SPECIAL, MANY, KINDS};
+
+static const char * kinds[KINDS] = {"uniforme", "fronteira", "empates", "duplicatas",
+		"nan/inf", "muitos objetivos"};
+
+/**
+ * Conjunto de vetores (um por linha) de um caso de teste.
+ */
+struct Case {
+	uint64_t seed;
+	int kind;
+	int n;
+	int M;
+	std::vector<int> sense;
+	std::vector<double> values;
+
+	double * row (int i) { return &values[(size_t) i * M]; }
+	const double * row (int i) const { return &values[(size_t) i * M]; }
+};
+
+/**
+ * Indivíduo mínimo para os motores que recebem Individual ** (obj).
+ */
+struct Point {
+	double * obj;
+};
+
+static std::string format (const char * pattern, ...) {
+	char text[256];
+	va_list args;
+	va_start (args, pattern);
+	vsnprintf (text, sizeof (text), pattern, args);
+	va_end (args);
+	return text;
+}
+
+static Case generate (uint64_t seed, int size, int objectives) {
+
+	Random random (seed);
+
+	Case c;
+	c.seed = seed;
+	c.kind = random.nextInt (KINDS);
+	c.M = c.kind == MANY ? 16 + random.nextInt (49) : 1 + random.nextInt (objectives);
+	c.n = random.nextInt (size + 1);
+
+	c.sense.resize (c.M);
+	for (int j=0; j < c.M; j++) c.sense[j] = random.nextInt (2) ? 1 : -1;
+
+	const double special[] = {std::numeric_limits<double>::quiet_NaN (),
+			std::numeric_limits<double>::infinity (), -std::numeric_limits<double>::infinity (),
+			-0.0, 0.0};
+
+	c.values.resize ((size_t) c.n * c.M);
+	for (int i=0; i < c.n; i++) {
+		double * v = c.row (i);
+
+		if (c.kind == FRONT) {
+			//pontos da esfera afastados por um ruído: fronteira com alguns dominados
+			double norm = 0.0;
+			for (int j=0; j < c.M; j++) {
+				v[j] = random.nextDouble () + 1e-9;
+				norm += v[j] * v[j];
+			}
+			double radius = 1.0 + 0.1 * random.nextDouble ();
+			for (int j=0; j < c.M; j++) v[j] = (2.0 - v[j] * radius / std::sqrt (norm)) * c.sense[j];
+
+		} else if (c.kind == DUPLICATES && i > 0 && random.nextInt (2)) {
+			const double * source = c.row (random.nextInt (i));
+			std::copy (source, source + c.M, v);
+
+		} else {
+			for (int j=0; j < c.M; j++) {
+				if (c.kind == TIES) v[j] = random.nextInt (3);
+				else if (c.kind == SPECIAL && random.nextInt (8) == 0) v[j] = special[random.nextInt (5)];
+				else v[j] = random.nextDouble ();
+			}
+		}
+	}
+	return c;
+}
+
+/**
+ * Cópia do caso com os valores não finitos trocados por 0.5.
+ */
+static Case finite (const Case & c) {
+	Case f = c;
+	for (unsigned k=0; k < f.values.size (); k++) {
+		if (!std::isfinite (f.values[k])) f.values[k] = 0.5;
+	}
+	return f;
+}
+
+static void points (Case & c, std::vector<Point> & storage, std::vector<Point *> & population) {
+	storage.resize (c.n);
+	population.resize (c.n);
+	for (int i=0; i < c.n; i++) {
+		storage[i].obj = c.row (i);
+		population[i] = &storage[i];
+	}
+}
+
+/**
+ * a não é pior que b em nenhum objetivo (dominância fraca). NaN não é
+ * comparável com nenhum valor.
+ */
+static bool weak (const Case & c, const double * a, const double * b) {
+	for (int j=0; j < c.M; j++) {
+		if (c.sense[j] > 0 ? !(a[j] <= b[j]) : !(a[j] >= b[j])) return false;
+	}
+	return true;
+}
+
+static bool same (const Case & c, const double * a, const double * b) {
+	for (int j=0; j < c.M; j++) {
+		if (!(a[j] == b[j])) return false;
+	}
+	return true;
+}
+
+/**
+ * Quantidade de vetores que dominam cada vetor; entre vetores iguais
+ * apenas o de menor índice é dominado.
+ */
+static void bruteCount (const Case & c, std::vector<int> & counts) {
+	counts.assign (c.n, 0);
+	for (int i=0; i < c.n; i++) {
+		for (int k=0; k < c.n; k++) {
+			if (k == i || !weak (c, c.row (k), c.row (i))) continue;
+			if (k < i && same (c, c.row (k), c.row (i))) continue;
+			counts[i]++;
+		}
+	}
+}
+
+static std::string checkDominate (Case & c) {
+	for (int i=0; i < c.n; i++) {
+		for (int k=0; k < c.n; k++) {
+			bool expected = weak (c, c.row (k), c.row (i));
+			bool result = MultiObjective::dominate (c.row (k), c.row (i)) == MultiObjective::DOMINATED;
+			if (result != expected) return format ("dominate (%d, %d) = %d, esperado %d", k, i, result, expected);
+		}
+	}
+	return "";
+}
+
+static std::string checkCount (const Case & c, ThreadPool * pool) {
+
+	std::vector<int> expected, counts;
+	bruteCount (c, expected);
+
+	DominanceSort sort (c.M, &c.sense[0], pool);
+	sort.count (c.values.data (), c.n, counts);
+
+	for (int i=0; i < c.n; i++) {
+		if (counts[i] != expected[i]) return format ("counts[%d] = %d, esperado %d", i, counts[i], expected[i]);
+	}
+	return "";
+}
+
+/**
+ * Contagem por índices (Individual **, como no Nsga2) sobre uma
+ * permutação dos vetores.
+ */
+static std::string checkCountIndex (Case & c) {
+
+	Random random (c.seed ^ 0x5bd1e995);
+	std::vector<int> index (c.n);
+	for (int i=0; i < c.n; i++) index[i] = i;
+	for (int i=c.n - 1; i > 0; i--) std::swap (index[i], index[random.nextInt (i + 1)]);
+
+	Case permuted = c;
+	for (int k=0; k < c.n; k++) std::copy (c.row (index[k]), c.row (index[k]) + c.M, permuted.row (k));
+
+	std::vector<int> expected, counts;
+	bruteCount (permuted, expected);
+
+	std::vector<Point> storage;
+	std::vector<Point *> population;
+	points (c, storage, population);
+
+	DominanceSort sort (c.M, &c.sense[0]);
+	sort.count (population.data (), index.data (), c.n, counts);
+
+	for (int k=0; k < c.n; k++) {
+		if (counts[k] != expected[k]) return format ("counts[%d] = %d, esperado %d", k, counts[k], expected[k]);
+	}
+	return "";
+}
+
+static std::string checkNondominated (const Case & c, ThreadPool * pool) {
+
+	std::vector<int> expected;
+	bruteCount (c, expected);
+
+	std::vector<char> front;
+	DominanceSort sort (c.M, &c.sense[0], pool);
+	sort.nondominated (c.values.data (), c.n, front);
+
+	for (int i=0; i < c.n; i++) {
+		if (front[i] != (expected[i] == 0)) {
+			return format ("nondominated[%d] = %d, esperado %d", i, front[i], expected[i] == 0);
+		}
+	}
+	return "";
+}
+
+/**
+ * Sem NaN, não estritamente dominado e, entre vetores iguais, o primeiro
+ * pela origem e pela posição.
+ */
+static std::string checkFrontMerge (const Case & c) {
+
+	Random random (c.seed ^ 0x27d4eb2f);
+	FrontMerge::Set set;
+	set.values = c.values;
+	for (int i=0; i < c.n; i++) set.origin.push_back (random.nextInt (4));
+
+	FrontMerge::Set expected;
+	for (int i=0; i < c.n; i++) {
+		const double * v = c.row (i);
+		bool keep = same (c, v, v); //sem NaN
+		for (int k=0; k < c.n && keep; k++) {
+			const double * u = c.row (k);
+			if (k == i || !same (c, u, u) || !weak (c, u, v)) continue;
+			if (!same (c, u, v)) keep = false;
+			else if (std::make_pair (set.origin[k], k) < std::make_pair (set.origin[i], i)) keep = false;
+		}
+		if (keep) {
+			expected.values.insert (expected.values.end (), v, v + c.M);
+			expected.origin.push_back (set.origin[i]);
+		}
+	}
+
+	FrontMerge::nondominated (set, c.M, &c.sense[0]);
+
+	if (set.rows () != expected.rows ()) return format ("%d vetores, esperado %d", set.rows (), expected.rows ());
+	if (!Reproducible::identical (set.values, expected.values) || set.origin != expected.origin) {
+		return "vetores mantidos diferem";
+	}
+	return "";
+}
+
+static std::string checkEpsilonArchive (const Case & c) {
+
+	Random random (c.seed ^ 0x165667b1);
+	std::vector<double> epsilon (c.M);
+	for (int j=0; j < c.M; j++) epsilon[j] = c.kind == TIES ? 1.0 : 0.05 + 0.45 * random.nextDouble ();
+
+	auto box = [&c, &epsilon] (const double * v, int j) {
+		return (int64_t) std::floor (v[j] * c.sense[j] / epsilon[j]);
+	};
+	auto covers = [&c, &box] (const double * a, const double * b) {
+		for (int j=0; j < c.M; j++) {
+			if (box (a, j) > box (b, j)) return false;
+		}
+		return true;
+	};
+	auto valid = [&c] (const double * v) {
+		for (int j=0; j < c.M; j++) {
+			if (!std::isfinite (v[j])) return false;
+		}
+		return true;
+	};
+
+	EpsilonArchive archive (&epsilon[0]);
+	for (int i=0; i < c.n; i++) {
+		if (archive.insert (c.row (i)) && !valid (c.row (i))) return format ("vetor %d não finito aceito", i);
+	}
+
+	const int size = archive.size ();
+	for (int a=0; a < size; a++) {
+
+		//cada vetor do arquivo é um dos vetores oferecidos
+		bool offered = false;
+		for (int i=0; i < c.n && !offered; i++) {
+			offered = memcmp (archive.row (a), c.row (i), c.M * sizeof (double)) == 0;
+		}
+		if (!offered) return format ("vetor %d do arquivo não foi oferecido", a);
+
+		//caixas diferentes e não dominadas entre si
+		for (int b=0; b < size; b++) {
+			if (a != b && covers (archive.row (a), archive.row (b))) {
+				return format ("caixa do vetor %d cobre a do vetor %d do arquivo", a, b);
+			}
+		}
+
+		//nenhum vetor oferecido da mesma caixa domina o ocupante
+		for (int i=0; i < c.n; i++) {
+			const double * v = c.row (i);
+			if (valid (v) && covers (v, archive.row (a)) && covers (archive.row (a), v) &&
+					weak (c, v, archive.row (a)) && !same (c, v, archive.row (a))) {
+				return format ("vetor %d domina o ocupante %d da sua caixa", i, a);
+			}
+		}
+	}
+
+	//todo vetor finito oferecido é coberto por uma caixa do arquivo
+	for (int i=0; i < c.n; i++) {
+		if (!valid (c.row (i))) continue;
+		bool covered = false;
+		for (int a=0; a < size && !covered; a++) covered = covers (archive.row (a), c.row (i));
+		if (!covered) return format ("vetor %d não é coberto pelo arquivo", i);
+	}
+	return "";
+}
+
+static std::string checkGridDensity (Case & c) {
+
+	static const int divisions[] = {1, 2, 3, 4, 16, 64};
+	Random random (c.seed ^ 0x85ebca6b);
+	const int d = divisions[random.nextInt (6)];
+
+	std::vector<Point> storage;
+	std::vector<Point *> population;
+	points (c, storage, population);
+
+	GridDensity grid (d);
+	grid.load (population.data (), c.n);
+
+	//células calculadas de forma independente
+	std::vector<double> lower (c.M, std::numeric_limits<double>::max ());
+	std::vector<double> upper (c.M, -std::numeric_limits<double>::max ());
+	for (int i=0; i < c.n; i++) {
+		for (int j=0; j < c.M; j++) {
+			lower[j] = std::min (lower[j], c.row (i)[j]);
+			upper[j] = std::max (upper[j], c.row (i)[j]);
+		}
+	}
+
+	std::map<std::vector<int>, int> occupancy;
+	std::vector<std::vector<int> > cell (c.n, std::vector<int> (c.M));
+	for (int i=0; i < c.n; i++) {
+		for (int j=0; j < c.M; j++) {
+			double range = upper[j] - lower[j];
+			double x = range > 0.0 ? std::floor ((c.row (i)[j] - lower[j]) / range * d) : 0.0;
+			cell[i][j] = x > 0.0 ? (int) std::min (x, (double) (d - 1)) : 0;
+		}
+		occupancy[cell[i]]++;
+	}
+
+	//com chave por hash células diferentes podem ser unidas
+	const bool exact = c.M * std::log2 ((double) d) < 63.0;
+
+	if (exact && grid.cells () != (int) occupancy.size ()) {
+		return format ("%d células (divisions %d), esperado %d", grid.cells (), d, (int) occupancy.size ());
+	}
+	for (int i=0; i < c.n; i++) {
+		int expected = occupancy[cell[i]];
+		if (exact ? grid.occupancy (i) != expected : grid.occupancy (i) < expected) {
+			return format ("occupancy (%d) = %d, esperado %d (divisions %d)", i, grid.occupancy (i), expected, d);
+		}
+	}
+	if (!exact) return "";
+
+	//truncamento: cada remoção sai de uma célula de ocupação máxima
+	int remove = random.nextInt (c.n + 3);
+	std::vector<char> removed;
+	grid.truncate (remove, removed);
+
+	std::map<std::vector<int>, int> kept;
+	int count = 0;
+	for (int i=0; i < c.n; i++) {
+		if (removed[i]) count++;
+		else kept[cell[i]]++;
+	}
+	if (count != std::min (remove, c.n)) return format ("%d removidos, esperado %d", count, std::min (remove, c.n));
+
+	int top = 0;
+	for (std::map<std::vector<int>, int>::iterator it = kept.begin (); it != kept.end (); ++it) {
+		top = std::max (top, it->second);
+	}
+	for (std::map<std::vector<int>, int>::iterator it = occupancy.begin (); it != occupancy.end (); ++it) {
+		int k = kept.count (it->first) ? kept[it->first] : 0;
+		if (k < it->second && k < top - 1) {
+			return format ("célula com %d de %d vetores mantidos, máximo %d", k, it->second, top);
+		}
+	}
+	for (int i=0; i < c.n; i++) {
+		if (!removed[i] && grid.occupancy (i) != kept[cell[i]]) {
+			return format ("occupancy (%d) = %d após truncate, esperado %d", i, grid.occupancy (i), kept[cell[i]]);
+		}
+	}
+	return "";
+}
+
+/**
+ * Quadrado da distância entre os vetores a e b na precisão Real, na
+ * ordem dos objetivos (a mesma soma do DistanceEngine).
+ */
+template <class Real>
+static Real distance (const Case & c, int a, int b) {
+	Real sum = 0;
+	for (int j=0; j < c.M; j++) {
+		Real d = (Real) c.row (a)[j] - (Real) c.row (b)[j];
+		sum += d * d;
+	}
+	return sum;
+}
+
+template <class Real>
+static bool near (double value, double expected) {
+	const double tolerance = sizeof (Real) == sizeof (float) ? 1e-4 : 1e-12;
+	return std::fabs (value - expected) <= tolerance * std::max (1.0, std::fabs (expected));
+}
+
+template <class Real>
+static std::string checkDistance (const Case & original) {
+
+	Case c = finite (original);
+	const bool single = sizeof (Real) == sizeof (float);
+
+	Random random (c.seed ^ 0xc2b2ae35);
+	int k = random.nextInt (c.n + 1);
+
+	std::vector<Point> storage;
+	std::vector<Point *> population;
+	points (c, storage, population);
+
+	DistanceEngine engine (single);
+	engine.load (population.data (), c.n);
+
+	std::vector<double> out;
+	engine.kthNearest (k, out);
+	if ((int) out.size () != c.n) return format ("kthNearest com %d valores, esperado %d", (int) out.size (), c.n);
+
+	std::vector<Real> row (c.n);
+	for (int i=0; i < c.n; i++) {
+		for (int j=0; j < c.n; j++) row[j] = distance<Real> (c, i, j);
+		std::sort (row.begin (), row.end ());
+		double expected = row[std::min (k, c.n - 1)];
+		if (!near<Real> (out[i], expected)) return format ("kthNearest (%d)[%d] = %g, esperado %g", k, i, out[i], expected);
+	}
+
+	//truncamento: o par mais próximo (primeiro na ordem de (i, j)) entre os presentes
+	std::vector<char> alive (c.n, 1);
+	engine.beginTruncation ();
+	for (int step=0; step < std::min (c.n - 2, 32); step++) {
+
+		int best = -1;
+		Real min = std::numeric_limits<Real>::max ();
+		std::vector<Real> nearest (c.n, std::numeric_limits<Real>::max ());
+		for (int i=0; i < c.n; i++) {
+			if (!alive[i]) continue;
+			for (int j=i+1; j < c.n; j++) {
+				if (!alive[j]) continue;
+				Real d = distance<Real> (c, i, j);
+				nearest[i] = std::min (nearest[i], d);
+				if (d < min) {
+					min = d;
+					best = i;
+				}
+			}
+		}
+
+		int closest = engine.closest ();
+		if (closest < 0 || !alive[closest]) return format ("closest = %d, vetor ausente", closest);
+		if (closest != best && !near<Real> (nearest[closest], min)) {
+			return format ("closest = %d (%g), esperado %d (%g)", closest, (double) nearest[closest], best, (double) min);
+		}
+
+		int position = 0;
+		for (int i=0; i < closest; i++) position += alive[i];
+		if (engine.position (closest) != position) {
+			return format ("position (%d) = %d, esperado %d", closest, engine.position (closest), position);
+		}
+
+		engine.remove (closest);
+		alive[closest] = 0;
+	}
+	return "";
+}
+
+/**
+ * A soma em ordem fixa é a mesma, bit a bit, com e sem threads.
+ */
+static std::string checkSum (const Case & c, ThreadPool * pool) {
+
+	Random random (c.seed ^ 0x9e3779b9);
+	int size = random.nextInt (4 * Reproducible::BLOCK + 1);
+
+	std::vector<double> values (size);
+	double naive = 0.0, magnitude = 0.0;
+	for (int i=0; i < size; i++) {
+		double v = c.values.empty () ? 0.0 : c.values[i % c.values.size ()];
+		values[i] = std::isfinite (v) ? v * (1.0 + random.nextDouble ()) : random.nextDouble ();
+		naive += values[i];
+		magnitude += std::fabs (values[i]);
+	}
+
+	double serial = Reproducible::sum (values.data (), size);
+	double parallel = Reproducible::sum (values.data (), size, pool);
+	if (memcmp (&serial, &parallel, sizeof (double)) != 0) {
+		return format ("sum (%d) com threads = %.17g, serial %.17g", size, parallel, serial);
+	}
+	if (std::fabs (serial - naive) > 1e-12 * std::max (1.0, magnitude)) {
+		return format ("sum (%d) = %.17g, esperado %.17g", size, serial, naive);
+	}
+	return "";
+}
+
+/**
+ * Casos e falhas de cada motor.
+ */
+class Results {
+
+public:
+
+	void record (const char * engine, const Case & c, const std::string & error) {
+
+		unsigned e = 0;
+		while (e < m_totals.size () && m_totals[e].name != engine) e++;
+		if (e == m_totals.size ()) m_totals.push_back (Totals (engine));
+
+		Totals & t = m_totals[e];
+		t.cases++;
+		if (error.empty ()) return;
+
+		//apenas as primeiras falhas de cada motor são descritas
+		if (++t.failures <= 5) {
+			fprintf (stderr, "%s: semente %llu (%s, n=%d, m=%d): %s\n", engine,
+					(unsigned long long) c.seed, kinds[c.kind], c.n, c.M, error.c_str ());
+		}
+	}
+
+	int failures () const {
+		int failures = 0;
+		for (unsigned e=0; e < m_totals.size (); e++) failures += m_totals[e].failures;
+		return failures;
+	}
+
+	void print (FILE * out) const {
+		fprintf (out, "%-24s %8s %8s\n", "motor", "casos", "falhas");
+		for (unsigned e=0; e < m_totals.size (); e++) {
+			fprintf (out, "%-24s %8d %8d\n", m_totals[e].name.c_str (), m_totals[e].cases, m_totals[e].failures);
+		}
+	}
+
+private:
+
+	struct Totals {
+		Totals (const char * engine) : name (engine), cases (0), failures (0) {}
+
+		std::string name;
+		int cases;
+		int failures;
+	};
+
+	std::vector<Totals> m_totals;
+};
+
+int main (int argc, char ** argv) {
+
+	int iterations = 200;
+	uint64_t seed = 1;
+	int size = 200;
+	int objectives = 8;
+	int threads = 4;
+
+	for (int i=1; i < argc; i++) {
+		if (i + 1 < argc && strcmp (argv[i], "-iterations") == 0) iterations = atoi (argv[++i]);
+		else if (i + 1 < argc && strcmp (argv[i], "-seed") == 0) seed = strtoull (argv[++i], NULL, 10);
+		else if (i + 1 < argc && strcmp (argv[i], "-n") == 0) size = atoi (argv[++i]);
+		else if (i + 1 < argc && strcmp (argv[i], "-m") == 0) objectives = atoi (argv[++i]);
+		else if (i + 1 < argc && strcmp (argv[i], "-t") == 0) threads = atoi (argv[++i]);
+		else {
+			fprintf (stderr, "uso: engine_check [-iterations n] [-seed s] [-n vetores] [-m objetivos] [-t threads]\n");
+			return 1;
+		}
+	}
+	if (size < 0) size = 0;
+	if (objectives < 1) objectives = 1;
+	if (threads < 2) threads = 2;
+
+	ThreadPool pool (threads);
+	Results results;
+
+	for (int it=0; it < iterations; it++) {
+
+		Case c = generate (seed + it, size, objectives);
+
+		//dominância e ε de MultiObjective e EpsilonArchive
+		Info::Scope scope (c.M, &c.sense[0], NULL);
+
+		results.record ("dominate", c, checkDominate (c));
+		results.record ("count", c, checkCount (c, NULL));
+		results.record ("count (threads)", c, checkCount (c, &pool));
+		results.record ("count (indices)", c, checkCountIndex (c));
+		results.record ("nondominated", c, checkNondominated (c, NULL));
+		results.record ("nondominated (threads)", c, checkNondominated (c, &pool));
+		results.record ("front merge", c, checkFrontMerge (c));
+		results.record ("epsilon archive", c, checkEpsilonArchive (c));
+		results.record ("grid density", c, checkGridDensity (c));
+		results.record ("distance (double)", c, checkDistance<double> (c));
+		results.record ("distance (float)", c, checkDistance<float> (c));
+		results.record ("sum", c, checkSum (c, &pool));
+	}
+
+	results.print (stdout);
+	return results.failures () > 0 ? 1 : 0;
+}
@@ -0,0 +1,142 @@
+/**
+ * Conversor entre o formato texto do PISA e o formato binário
+ * colunar de fronteiras (front_file.h).
+ *
+ * Uso:
+ *
+ *		front_convert to-binary <entrada.txt> <saida.bin> [-delta] [-conf objconf] [-run id]
+ *		front_convert to-text <entrada.bin> <saida.txt>
+ *
+ * Na conversão para binário cada fronteira do arquivo texto (separadas
+ * por linha em branco) vira um bloco, com a geração igual à posição
+ * da fronteira no arquivo. O arquivo de configuração de objetivos é o
+ * mesmo utilizado por ProblemInfo; sem ele todos os objetivos são
+ * considerados de minimização.
+ *
+ * Compilação: g++ -std=c++17 -O2 -I.. front_convert.cpp -o front_convert
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <charconv>
+
+#include "../front_file.h"
+
+static int usage () {
+	fprintf (stderr, "uso: front_convert to-binary <entrada> <saida> [-delta] [-conf objconf] [-run id]\n");
+	fprintf (stderr, "     front_convert to-text <entrada> <saida>\n");
+	return 1;
+}
+
+static int toBinary (int argc, char ** argv) {
+
+	FrontFile::Encoding encoding = FrontFile::RAW;
+	std::vector<int> sense;
+	uint64_t run = 0;
+
+	for (int i=4; i < argc; i++) {
+		if (strcmp (argv[i], "-delta") == 0) {
+			encoding = FrontFile::DELTA;
+		} else if (strcmp (argv[i], "-conf") == 0 && i + 1 < argc) {
+			std::ifstream conf (argv[++i]);
+			int value;
+			while (conf >> value) sense.push_back (value);
+		} else if (strcmp (argv[i], "-run") == 0 && i + 1 < argc) {
+			run = strtoull (argv[++i], NULL, 10);
+		} else {
+			return usage ();
+		}
+	}
+
+	MappedFile in (argv[2]);
+	if (in.data () == NULL) {
+		fprintf (stderr, "não foi possível ler %s\n", argv[2]);
+		return 1;
+	}
+
+	FILE * out = fopen (argv[3], "wb");
+	if (out == NULL) {
+		fprintf (stderr, "não foi possível criar %s\n", argv[3]);
+		return 1;
+	}
+
+	int objectives = sense.empty () ? 0 : (int) sense.size ();
+	int generation = 0;
+	bool header = false;
+	bool ok = true;
+	std::vector<char> scratch;
+
+	objectives = FrontFile::parseText (in.data (), in.size (), objectives,
+		[&](const std::vector<double> & values, int rows) {
+			int M = (int) (values.size () / rows);
+			if (!header) {
+				ok = FrontFile::writeHeader (out, M, sense.empty () ? NULL : &sense[0]) && ok;
+				header = true;
+			}
+			ok = FrontFile::writeBlock (out, values.data (), rows, M,
+					generation++, run, encoding, scratch) && ok;
+		});
+
+	if (!header && objectives > 0) {
+		ok = FrontFile::writeHeader (out, objectives, sense.empty () ? NULL : &sense[0]) && ok;
+	}
+
+	ok = (fclose (out) == 0) && ok;
+	fprintf (stderr, "%d fronteiras convertidas\n", generation);
+	return ok ? 0 : 1;
+}
+
+static int toText (char ** argv) {
+
+	FrontFile::Reader reader (argv[2]);
+	if (!reader.valid ()) {
+		fprintf (stderr, "%s não é um arquivo binário de fronteiras\n", argv[2]);
+		return 1;
+	}
+
+	FILE * out = fopen (argv[3], "w");
+	if (out == NULL) {
+		fprintf (stderr, "não foi possível criar %s\n", argv[3]);
+		return 1;
+	}
+	setvbuf (out, NULL, _IOFBF, 1 << 20);
+
+	const int M = reader.objectives ();
+	std::vector<char> line (M * 32);
+	FrontFile::Block block;
+	int fronts = 0;
+
+	while (reader.next (block)) {
+		for (int i=0; i < block.rows; i++) {
+			char * p = &line[0];
+			for (int j=0; j < M; j++) {
+				p = std::to_chars (p, p + 31, block.value (i, j)).ptr;
+				*p++ = (j + 1 < M ? ' ' : '\n');
+			}
+			fwrite (&line[0], 1, p - &line[0], out);
+		}
+		fputc ('\n', out);
+		fronts++;
+	}
+
+	bool ok = fclose (out) == 0;
+	fprintf (stderr, "%d fronteiras convertidas\n", fronts);
+	if (!reader.complete ()) {
+		fprintf (stderr, "%s: bloco %d truncado ou corrompido\n", argv[2], fronts);
+		return 1;
+	}
+	return ok ? 0 : 1;
+}
+
+int main (int argc, char ** argv) {
+
+	if (argc < 4) return usage ();
+
+	if (strcmp (argv[1], "to-binary") == 0) return toBinary (argc, argv);
+	if (strcmp (argv[1], "to-text") == 0 && argc == 4) return toText (argv);
+
+	return usage ();
+}
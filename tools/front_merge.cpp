@@ -0,0 +1,165 @@
+/**
+ * União das fronteiras de muitas execuções (arquivos gravados por
+ * printArc, em texto do PISA ou binários) em uma fronteira de
+ * referência (front_merge.h).
+ *
+ * Uso:
+ *
+ *		front_merge [-t threads] [-conf objconf] [-o referencia] [-stats estatisticas]
+ *					[-list lista] [arquivos...]
+ *
+ * Os arquivos são dados na linha de comando ou em um arquivo de lista
+ * (um nome por linha), para campanhas com milhares de arquivos. Cada
+ * arquivo é reduzido ao seu conjunto não dominado em paralelo e os
+ * conjuntos são unidos por uma redução em árvore.
+ *
+ * A fronteira de referência é gravada no formato texto do PISA (sem
+ * -o, na saída padrão). As estatísticas trazem, por arquivo, os vetores
+ * lidos, os não dominados do arquivo e a contribuição para a referência.
+ *
+ * O arquivo de configuração de objetivos é o mesmo utilizado por
+ * ProblemInfo; sem ele todos os objetivos são de minimização e a
+ * quantidade de objetivos é a do primeiro arquivo lido.
+ *
+ * Compilação: g++ -std=c++17 -O2 -I.. front_merge.cpp -o front_merge -lpthread
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <thread>
+#include <charconv>
+
+#include "../thread_pool.h"
+#include "../front_merge.h"
+
+static int usage () {
+	fprintf (stderr, "uso: front_merge [-t threads] [-conf objconf] [-o referencia] [-stats estatisticas]\n");
+	fprintf (stderr, "                 [-list lista] [arquivos...]\n");
+	return 1;
+}
+
+int main (int argc, char ** argv) {
+
+	int threads = std::thread::hardware_concurrency ();
+	std::vector<int> sense;
+	std::string output, statistics;
+	std::vector<std::string> files;
+
+	for (int i=1; i < argc; i++) {
+		if (strcmp (argv[i], "-t") == 0 && i + 1 < argc) {
+			threads = atoi (argv[++i]);
+		} else if (strcmp (argv[i], "-conf") == 0 && i + 1 < argc) {
+			std::ifstream conf (argv[++i]);
+			int value;
+			while (conf >> value) sense.push_back (value);
+		} else if (strcmp (argv[i], "-o") == 0 && i + 1 < argc) {
+			output = argv[++i];
+		} else if (strcmp (argv[i], "-stats") == 0 && i + 1 < argc) {
+			statistics = argv[++i];
+		} else if (strcmp (argv[i], "-list") == 0 && i + 1 < argc) {
+			std::ifstream list (argv[++i]);
+			std::string name;
+			while (std::getline (list, name)) {
+				if (!name.empty ()) files.push_back (name);
+			}
+		} else if (argv[i][0] == '-') {
+			return usage ();
+		} else {
+			files.push_back (argv[i]);
+		}
+	}
+	if (files.empty ()) return usage ();
+	if (threads < 1) threads = 1;
+
+	const int n = (int) files.size ();
+	int M = (int) sense.size ();
+
+	//sem configuração: objetivos do primeiro arquivo legível, minimização
+	std::vector<FrontMerge::Set> sets (n);
+	std::vector<FrontMerge::FileStats> stats (n);
+	std::vector<char> valid (n, 0);
+
+	int start = 0;
+	if (M == 0) {
+		int first = 0;
+		while (first < n && !(valid[first] = FrontMerge::read (files[first], 0, NULL,
+				first, sets[first], stats[first]))) first++;
+		if (first == n) {
+			fprintf (stderr, "nenhum arquivo pôde ser lido\n");
+			return 1;
+		}
+		M = stats[first].objectives;
+		sense.assign (M, 1);
+		start = first + 1;
+	}
+
+	ThreadPool pool (threads);
+
+	//conjunto não dominado de cada arquivo; cada tarefa lê um arquivo por vez
+	for (int i=start; i < n; i++) {
+		pool.submit ([&, i] {
+			valid[i] = FrontMerge::read (files[i], M, &sense[0], i, sets[i], stats[i]);
+			if (!valid[i]) sets[i].clear ();
+		});
+	}
+	pool.wait ();
+
+	int invalid = 0;
+	for (int i=0; i < n; i++) {
+		if (!valid[i]) {
+			fprintf (stderr, "%s ignorado: não pôde ser lido ou não possui %d objetivos\n",
+					files[i].c_str (), M);
+			invalid++;
+		}
+	}
+
+	FrontMerge::reduce (sets, M, &sense[0], &pool);
+	const FrontMerge::Set & reference = sets[0];
+
+	for (int r=0; r < reference.rows (); r++) stats[reference.origin[r]].contribution++;
+
+	//fronteira de referência
+	FILE * out = output.empty () ? stdout : fopen (output.c_str (), "w");
+	if (out == NULL) {
+		fprintf (stderr, "não foi possível criar %s\n", output.c_str ());
+		return 1;
+	}
+	setvbuf (out, NULL, _IOFBF, 1 << 20);
+
+	std::vector<char> line ((size_t) M * 32);
+	for (int r=0; r < reference.rows (); r++) {
+		char * p = &line[0];
+		for (int j=0; j < M; j++) {
+			p = std::to_chars (p, p + 31, reference.values[(size_t) r * M + j]).ptr;
+			*p++ = (j + 1 < M ? ' ' : '\n');
+		}
+		fwrite (&line[0], 1, p - &line[0], out);
+	}
+	bool ok = true;
+	if (out != stdout) ok = fclose (out) == 0;
+	else fflush (out);
+
+	//contribuição de cada arquivo
+	if (!statistics.empty ()) {
+		FILE * s = fopen (statistics.c_str (), "w");
+		if (s == NULL) {
+			fprintf (stderr, "não foi possível criar %s\n", statistics.c_str ());
+			return 1;
+		}
+		fprintf (s, "#arquivo fronteiras vetores nao_dominados contribuicao fracao\n");
+		for (int i=0; i < n; i++) {
+			if (!valid[i]) continue;
+			fprintf (s, "%s %d %llu %d %d %.4f\n", files[i].c_str (), stats[i].fronts,
+					(unsigned long long) stats[i].rows, stats[i].local, stats[i].contribution,
+					reference.rows () ? (double) stats[i].contribution / reference.rows () : 0.0);
+		}
+		ok = (fclose (s) == 0) && ok;
+	}
+
+	fprintf (stderr, "%d arquivos (%d ignorados), referência com %d vetores\n",
+			n, invalid, reference.rows ());
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,127 @@
+/**
+ * Entrada do libFuzzer para o leitor do formato binário de fronteiras
+ * (FrontFile::Reader), utilizado por MultiObjective::filter, pela
+ * conversão e pela união de fronteiras.
+ *
+ * Uso:
+ *
+ *		fuzz_front_binary [-max_len=4096] [corpus...]		(libFuzzer)
+ *		fuzz_front_binary_replay arquivos...				(sem libFuzzer)
+ *
+ * Cada entrada é lida bloco a bloco. Com AddressSanitizer qualquer
+ * leitura fora do arquivo ou do payload é uma falha. Cada bloco aceito
+ * é regravado (RAW e DELTA) e lido de novo: as linhas devem ser as
+ * mesmas, bit a bit (na mesma ordem em RAW, em qualquer ordem em
+ * DELTA). Uma diferença encerra o processo (abort).
+ *
+ * Para um corpus inicial, arquivos gravados por front_convert to-binary
+ * (com e sem -delta).
+ *
+ * Compilação: clang++ -std=c++17 -g -O1 -fsanitize=fuzzer,address -I.. fuzz_front_binary.cpp -o fuzz_front_binary
+ *
+ * Compilação (repetição de um corpus): g++ -std=c++17 -g -O1 -DFRONT_FUZZ_MAIN -I..
+ *		fuzz_front_binary.cpp -o fuzz_front_binary_replay
+ */
+#include <stdint.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iterator>
+#include <algorithm>
+
+#include "../front_file.h"
+
+static void check (bool condition, const char * what) {
+	if (!condition) {
+		fprintf (stderr, "fuzz_front_binary: %s\n", what);
+		abort ();
+	}
+}
+
+/**
+ * Linhas do bloco como sequências de bytes.
+ */
+static std::vector<std::string> rows (const FrontFile::Block & block, int objectives) {
+	std::vector<std::string> out (block.rows);
+	for (int i=0; i < block.rows; i++) {
+		for (int j=0; j < objectives; j++) {
+			double value = block.value (i, j);
+			out[i].append ((const char *) &value, sizeof (value));
+		}
+	}
+	return out;
+}
+
+/**
+ * Regrava o bloco com a codificação encoding e o lê de volta.
+ */
+static void roundTrip (const FrontFile::Block & block, int objectives, FrontFile::Encoding encoding) {
+
+	std::vector<double> values ((size_t) block.rows * objectives);
+	for (int i=0; i < block.rows; i++) {
+		for (int j=0; j < objectives; j++) values[(size_t) i * objectives + j] = block.value (i, j);
+	}
+
+	FILE * file = tmpfile ();
+	check (file != NULL, "tmpfile");
+	std::vector<char> scratch;
+	check (FrontFile::writeHeader (file, objectives, NULL), "writeHeader");
+	check (FrontFile::writeBlock (file, values.data (), block.rows, objectives, block.generation,
+			block.run, encoding, scratch), "writeBlock");
+
+	std::vector<double> image ((ftell (file) + 7) / 8);
+	rewind (file);
+	size_t size = fread (image.data (), 1, image.size () * 8, file);
+	fclose (file);
+
+	FrontFile::Reader reader ((const char *) image.data (), size);
+	FrontFile::Block copy;
+	check (reader.next (copy), "bloco regravado não pode ser lido");
+	check (copy.rows == block.rows && copy.generation == block.generation && copy.run == block.run,
+			"cabeçalho do bloco regravado");
+
+	std::vector<std::string> a = rows (block, objectives);
+	std::vector<std::string> b = rows (copy, objectives);
+	if (encoding == FrontFile::DELTA) {
+		std::sort (a.begin (), a.end ());
+		std::sort (b.begin (), b.end ());
+	}
+	check (a == b, encoding == FrontFile::RAW ? "valores regravados (RAW)" : "valores regravados (DELTA)");
+	check (!reader.next (copy), "bloco extra");
+}
+
+extern "C" int LLVMFuzzerTestOneInput (const uint8_t * data, size_t size) {
+
+	//cópia alinhada em 8 bytes, como o arquivo mapeado
+	std::vector<double> aligned ((size + 7) / 8);
+	if (size > 0) memcpy (aligned.data (), data, size);
+
+	FrontFile::Reader reader ((const char *) aligned.data (), size);
+	if (!reader.valid ()) return 0;
+
+	const int M = reader.objectives ();
+	FrontFile::Block block;
+	for (int b=0; reader.next (block); b++) {
+		check (block.rows >= 0 && (int) block.columns.size () == M, "bloco");
+		rows (block, M);
+		if (b < 4 && (size_t) block.rows * M <= 4096) {
+			roundTrip (block, M, FrontFile::RAW);
+			roundTrip (block, M, FrontFile::DELTA);
+		}
+	}
+	return 0;
+}
+
+#ifdef FRONT_FUZZ_MAIN
+int main (int argc, char ** argv) {
+	for (int i=1; i < argc; i++) {
+		std::ifstream in (argv[i], std::ios::binary);
+		std::string text ((std::istreambuf_iterator<char> (in)), std::istreambuf_iterator<char> ());
+		LLVMFuzzerTestOneInput ((const uint8_t *) text.data (), text.size ());
+	}
+	return 0;
+}
+#endif
@@ -0,0 +1,148 @@
+/**
+ * Entrada do libFuzzer para o leitor de fronteiras texto do PISA
+ * (FrontFile::parseText), utilizado por MultiObjective::filter, pela
+ * conversão e pela união de fronteiras.
+ *
+ * Uso:
+ *
+ *		fuzz_front_text [-max_len=4096] [corpus...]		(libFuzzer)
+ *		fuzz_front_text_replay arquivos...				(sem libFuzzer)
+ *
+ * Cada entrada é lida com a quantidade de objetivos dada pela primeira
+ * linha e com três objetivos, e o resultado é comparado com um leitor
+ * de referência que separa as linhas e os valores com std::string:
+ * mesmas fronteiras, mesmos valores (bit a bit) e mesma quantidade de
+ * objetivos. Uma diferença encerra o processo (abort), que o libFuzzer
+ * registra como falha junto com a entrada.
+ *
+ * Compilação: clang++ -std=c++17 -g -O1 -fsanitize=fuzzer,address -I.. fuzz_front_text.cpp -o fuzz_front_text
+ *
+ * Compilação (repetição de um corpus): g++ -std=c++17 -g -O1 -DFRONT_FUZZ_MAIN -I..
+ *		fuzz_front_text.cpp -o fuzz_front_text_replay
+ */
+#include <stdint.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iterator>
+#include <charconv>
+
+#include "../front_file.h"
+
+/**
+ * Fronteiras lidas: valores de cada fronteira, um vetor por linha.
+ */
+struct Fronts {
+	std::vector<std::vector<double> > values;
+	std::vector<int> rows;
+	int objectives;
+};
+
+/**
+ * Leitor de referência: linhas e valores separados com std::string;
+ * uma linha vazia ou com um valor inválido separa as fronteiras.
+ */
+static void reference (const std::string & text, int objectives, Fronts & fronts) {
+
+	std::vector<double> values;
+	int rows = 0;
+
+	size_t begin = 0;
+	while (begin < text.size ()) {
+
+		size_t end = text.find ('\n', begin);
+		bool last = end == std::string::npos;
+		std::string line = text.substr (begin, last ? std::string::npos : end - begin);
+
+		std::vector<double> row;
+		size_t p = 0;
+		while ((p = line.find_first_not_of (" \t\r", p)) != std::string::npos) {
+			size_t q = line.find_first_of (" \t\r", p);
+			std::string token = line.substr (p, q == std::string::npos ? std::string::npos : q - p);
+
+			double value;
+			std::from_chars_result r = std::from_chars (token.data (), token.data () + token.size (), value);
+			if (r.ec != std::errc () || r.ptr != token.data () + token.size ()) {
+				row.clear ();
+				break;
+			}
+			row.push_back (value);
+			p = q;
+		}
+
+		if (row.empty ()) {
+			if (!last && rows > 0) {
+				fronts.values.push_back (values);
+				fronts.rows.push_back (rows);
+				values.clear ();
+				rows = 0;
+			}
+		} else {
+			if (objectives <= 0) objectives = (int) row.size ();
+			if ((int) row.size () == objectives) {
+				values.insert (values.end (), row.begin (), row.end ());
+				rows++;
+			}
+		}
+
+		if (last) break;
+		begin = end + 1;
+	}
+
+	if (rows > 0) {
+		fronts.values.push_back (values);
+		fronts.rows.push_back (rows);
+	}
+	fronts.objectives = objectives;
+}
+
+static void check (bool condition, const char * what) {
+	if (!condition) {
+		fprintf (stderr, "fuzz_front_text: %s\n", what);
+		abort ();
+	}
+}
+
+static void compare (const char * data, size_t size, int objectives) {
+
+	Fronts parsed;
+	parsed.objectives = FrontFile::parseText (data, size, objectives,
+		[&parsed] (const std::vector<double> & values, int rows) {
+			check (rows > 0, "fronteira vazia");
+			parsed.values.push_back (values);
+			parsed.rows.push_back (rows);
+		});
+
+	Fronts expected;
+	reference (std::string (data, size), objectives, expected);
+
+	check (parsed.objectives == expected.objectives, "quantidade de objetivos");
+	check (parsed.rows == expected.rows, "quantidade de fronteiras ou de linhas");
+	for (unsigned f=0; f < parsed.values.size (); f++) {
+		const std::vector<double> & a = parsed.values[f];
+		const std::vector<double> & b = expected.values[f];
+		check (a.size () == (size_t) parsed.rows[f] * parsed.objectives, "valores por linha");
+		check (a.size () == b.size () && (a.empty () || memcmp (&a[0], &b[0], a.size () * sizeof (double)) == 0),
+				"valores");
+	}
+}
+
+extern "C" int LLVMFuzzerTestOneInput (const uint8_t * data, size_t size) {
+	compare ((const char *) data, size, 0);
+	compare ((const char *) data, size, 3);
+	return 0;
+}
+
+#ifdef FRONT_FUZZ_MAIN
+int main (int argc, char ** argv) {
+	for (int i=1; i < argc; i++) {
+		std::ifstream in (argv[i], std::ios::binary);
+		std::string text ((std::istreambuf_iterator<char> (in)), std::istreambuf_iterator<char> ());
+		LLVMFuzzerTestOneInput ((const uint8_t *) text.data (), text.size ());
+	}
+	return 0;
+}
+#endif
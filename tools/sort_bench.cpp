@@ -0,0 +1,120 @@
+/**
+ * Medição de escalabilidade da contagem de dominância paralela
+ * (dominance_sort.h).
+ *
+ * Uso:
+ *
+ *		sort_bench [-n vetores] [-m objetivos] [-t threads] [-seed s] [-perf]
+ *
+ * Gera n vetores aleatórios próximos de uma fronteira côncava (mistura
+ * de fronteiras, como numa população 2N do Nsga2) e mede o tempo da
+ * contagem serial e da contagem com 1, 2, 4, ... até t threads. Cada
+ * contagem paralela é comparada com a serial.
+ *
+ * Com -perf cada contagem é medida também pelos contadores de hardware
+ * (profiler.h): IPC e faltas na L1, na LLC e de desvio por vetor, para
+ * distinguir um kernel limitado pela memória de um limitado pelo
+ * processamento. Sem contadores disponíveis apenas os tempos são
+ * mostrados.
+ *
+ * Compilação: g++ -std=c++17 -O2 -I.. sort_bench.cpp -o sort_bench -lpthread
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <string>
+
+#include "../random.h"
+#include "../thread_pool.h"
+#include "../dominance_sort.h"
+#include "../profiler.h"
+
+static double seconds (std::chrono::steady_clock::time_point start) {
+	return std::chrono::duration<double> (std::chrono::steady_clock::now () - start).count ();
+}
+
+int main (int argc, char ** argv) {
+
+	int n = 200000;
+	int m = 3;
+	int threads = std::thread::hardware_concurrency ();
+	uint64_t seed = 1;
+	bool perf = false;
+
+	for (int i=1; i < argc; i++) {
+		if (strcmp (argv[i], "-perf") == 0) perf = true;
+		else if (i + 1 < argc && strcmp (argv[i], "-n") == 0) n = atoi (argv[++i]);
+		else if (i + 1 < argc && strcmp (argv[i], "-m") == 0) m = atoi (argv[++i]);
+		else if (i + 1 < argc && strcmp (argv[i], "-t") == 0) threads = atoi (argv[++i]);
+		else if (i + 1 < argc && strcmp (argv[i], "-seed") == 0) seed = strtoull (argv[++i], NULL, 10);
+		else {
+			fprintf (stderr, "uso: sort_bench [-n vetores] [-m objetivos] [-t threads] [-seed s] [-perf]\n");
+			return 1;
+		}
+	}
+	if (threads < 1) threads = 1;
+
+	//criado antes dos pools para que as threads deles sejam contadas
+	Profiler profiler (perf);
+
+	//pontos sobre a esfera unitária afastados por um ruído
+	Random random (seed);
+	std::vector<double> values ((size_t) n * m);
+	for (int i=0; i < n; i++) {
+		double * v = &values[(size_t) i * m];
+		double norm = 0.0;
+		for (int j=0; j < m; j++) {
+			v[j] = random.nextDouble () + 1e-9;
+			norm += v[j] * v[j];
+		}
+		double radius = 1.0 + 0.5 * random.nextDouble ();
+		for (int j=0; j < m; j++) v[j] *= radius / std::sqrt (norm);
+	}
+
+	std::vector<int> sense (m, 1);
+	std::vector<int> reference, counts;
+
+	DominanceSort serial (m, &sense[0]);
+	if (perf) profiler.begin (profiler.add ("serial"), n);
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now ();
+	serial.count (&values[0], n, reference);
+	double base = seconds (start);
+	if (perf) profiler.end ();
+
+	int front = 0;
+	for (int i=0; i < n; i++) front += reference[i] == 0;
+
+	printf ("n=%d m=%d rank 0: %d\n", n, m, front);
+	printf ("%8s %12s %10s %10s\n", "threads", "segundos", "speedup", "correto");
+	printf ("%8s %12.4f %10.2f %10s\n", "serial", base, 1.0, "-");
+
+	for (int t=1; ; t *= 2) {
+
+		if (t > threads) t = threads;
+
+		ThreadPool pool (t);
+		DominanceSort parallel (m, &sense[0], &pool);
+
+		if (perf) profiler.begin (profiler.add (std::to_string (t) + " threads"), n);
+		start = std::chrono::steady_clock::now ();
+		parallel.count (&values[0], n, counts);
+		double elapsed = seconds (start);
+		if (perf) profiler.end ();
+
+		printf ("%8d %12.4f %10.2f %10s\n", t, elapsed, base / elapsed,
+				counts == reference ? "sim" : "NAO");
+
+		if (t == threads) break;
+	}
+
+	if (perf) {
+		printf ("\n");
+		profiler.print (stdout);
+	}
+
+	return 0;
+}
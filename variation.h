@@ -0,0 +1,602 @@
+#ifndef _VARIATION_H_
+#define _VARIATION_H_
+
+#include <stdint.h>
+#include <cmath>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+#include "random.h"
+#include "thread_pool.h"
+
+/**
+ * Operadores de variação em lote.
+ *
+ * Os algoritmos geram a prole em duas etapas: seleção (torneio, feita
+ * pelo algoritmo) e variação, delegada a Variation::recombine. Se a
+ * política de problema fornecer
+ *
+ *		void recombine (Individual ** p1, Individual ** p2, Individual ** children,
+ *						int size, double p_cross, double p_mut, Random & random);
+ *
+ * o lote inteiro de pais é entregue a ela. Caso contrário cada filho é
+ * gerado com Problem::crossover e Problem::mutation, como antes.
+ *
+ * Para genótipos do tipo std::vector<Gene> (reais, binários ou
+ * permutações), a classe Pipeline implementa recombine com os estágios
+ * cruzamento -> mutação -> reparo. Os genótipos do lote são copiados
+ * para buffers contíguos (linha i = genótipo i) e cada estágio processa
+ * blocos de linhas, opcionalmente em paralelo em um ThreadPool:
+ *
+ *		struct Zdt1 {
+ *			typedef std::vector<double> genotype_type;
+ *			Zdt1 () : pipeline (30) {
+ *				pipeline.setCrossover (Variation::SBX (lower, upper, 15.0));
+ *				pipeline.setMutation (Variation::PolynomialMutation (lower, upper, 20.0, 1.0/30));
+ *				pipeline.setRepair (Variation::Bounds (lower, upper));
+ *			}
+ *			template <class Individual>
+ *			void recombine (Individual ** p1, Individual ** p2, Individual ** children,
+ *							int size, double p_cross, double p_mut, Random & random) {
+ *				pipeline.apply (p1, p2, children, size, p_cross, p_mut, random);
+ *			}
+ *			Variation::Pipeline<double> pipeline;
+ *			...
+ *		};
+ *
+ * Cada bloco de linhas recebe o seu próprio gerador, semeado pelo
+ * gerador do algoritmo na ordem dos blocos. O resultado não depende
+ * da quantidade de threads nem da ordem em que os blocos executam.
+ *
+ * @date 18/10/2026
+ */
+namespace Variation {
+
+	/**
+	 * Quantidade de linhas processadas por bloco (e por gerador).
+	 */
+	const int BLOCK = 64;
+
+	/*--------------------------------------------------------------------
+	 * Operadores para vetores de reais
+	 *------------------------------------------------------------------*/
+
+	/**
+	 * Simulated Binary Crossover (Deb e Agrawal, 1995) respeitando os
+	 * limites de cada variável. Cada par de pais gera um filho; cada
+	 * variável é cruzada com probabilidade 0.5.
+	 */
+	struct SBX {
+
+		SBX (const std::vector<double> & lower, const std::vector<double> & upper, double eta = 15.0)
+			: m_lower (lower), m_upper (upper), m_eta (eta) {}
+
+		void operator() (const double * p1, const double * p2, double * child,
+						 int rows, int dim, Random & random) const {
+
+			std::vector<double> u ((size_t) rows * dim * 3);
+			random.fill (&u[0], u.size ());
+
+			const double exponent = 1.0 / (m_eta + 1.0);
+
+			for (int r=0; r < rows; r++) {
+				const double * a = p1 + (size_t) r * dim;
+				const double * b = p2 + (size_t) r * dim;
+				double * c = child + (size_t) r * dim;
+				const double * ur = &u[(size_t) r * dim * 3];
+
+				for (int j=0; j < dim; j++) {
+
+					double y1 = std::min (a[j], b[j]);
+					double y2 = std::max (a[j], b[j]);
+
+					if (ur[3*j] > 0.5 || y2 - y1 < 1e-14) {
+						c[j] = a[j];
+						continue;
+					}
+
+					double lo = m_lower[j], hi = m_upper[j];
+					double rand = ur[3*j + 1];
+
+					double beta = 1.0 + 2.0 * (y1 - lo) / (y2 - y1);
+					double alpha = 2.0 - std::pow (beta, -(m_eta + 1.0));
+					double betaq = rand <= 1.0 / alpha
+						? std::pow (rand * alpha, exponent)
+						: std::pow (1.0 / (2.0 - rand * alpha), exponent);
+					double c1 = 0.5 * ((y1 + y2) - betaq * (y2 - y1));
+
+					beta = 1.0 + 2.0 * (hi - y2) / (y2 - y1);
+					alpha = 2.0 - std::pow (beta, -(m_eta + 1.0));
+					betaq = rand <= 1.0 / alpha
+						? std::pow (rand * alpha, exponent)
+						: std::pow (1.0 / (2.0 - rand * alpha), exponent);
+					double c2 = 0.5 * ((y1 + y2) + betaq * (y2 - y1));
+
+					double value = ur[3*j + 2] < 0.5 ? c1 : c2;
+					c[j] = std::min (std::max (value, lo), hi);
+				}
+			}
+		}
+
+		std::vector<double> m_lower;
+		std::vector<double> m_upper;
+		double m_eta;
+	};
+
+	/**
+	 * Mutação polinomial (Deb e Goyal, 1996). Cada variável é mutada
+	 * com probabilidade rate.
+	 */
+	struct PolynomialMutation {
+
+		PolynomialMutation (const std::vector<double> & lower, const std::vector<double> & upper,
+							double eta = 20.0, double rate = 0.1)
+			: m_lower (lower), m_upper (upper), m_eta (eta), m_rate (rate) {}
+
+		void operator() (double * genes, int rows, int dim, Random & random) const {
+
+			std::vector<double> u ((size_t) rows * dim * 2);
+			random.fill (&u[0], u.size ());
+
+			const double exponent = 1.0 / (m_eta + 1.0);
+
+			for (int r=0; r < rows; r++) {
+				double * y = genes + (size_t) r * dim;
+				const double * ur = &u[(size_t) r * dim * 2];
+
+				for (int j=0; j < dim; j++) {
+
+					if (ur[2*j] >= m_rate) continue;
+
+					double lo = m_lower[j], hi = m_upper[j];
+					if (hi <= lo) continue;
+
+					double delta1 = (y[j] - lo) / (hi - lo);
+					double delta2 = (hi - y[j]) / (hi - lo);
+					double rand = ur[2*j + 1];
+
+					double deltaq;
+					if (rand < 0.5) {
+						double val = 2.0 * rand + (1.0 - 2.0 * rand) * std::pow (1.0 - delta1, m_eta + 1.0);
+						deltaq = std::pow (val, exponent) - 1.0;
+					} else {
+						double val = 2.0 * (1.0 - rand) + 2.0 * (rand - 0.5) * std::pow (1.0 - delta2, m_eta + 1.0);
+						deltaq = 1.0 - std::pow (val, exponent);
+					}
+
+					y[j] = std::min (std::max (y[j] + deltaq * (hi - lo), lo), hi);
+				}
+			}
+		}
+
+		std::vector<double> m_lower;
+		std::vector<double> m_upper;
+		double m_eta;
+		double m_rate;
+	};
+
+	/**
+	 * Reparo que projeta cada variável no intervalo [lower, upper].
+	 */
+	struct Bounds {
+
+		Bounds (const std::vector<double> & lower, const std::vector<double> & upper)
+			: m_lower (lower), m_upper (upper) {}
+
+		void operator() (double * genes, int rows, int dim) const {
+			for (int r=0; r < rows; r++) {
+				double * y = genes + (size_t) r * dim;
+				for (int j=0; j < dim; j++) {
+					y[j] = std::min (std::max (y[j], m_lower[j]), m_upper[j]);
+				}
+			}
+		}
+
+		std::vector<double> m_lower;
+		std::vector<double> m_upper;
+	};
+
+	/*--------------------------------------------------------------------
+	 * Operadores para vetores binários (um gene 0/1 por byte)
+	 *------------------------------------------------------------------*/
+
+	/**
+	 * Cruzamento uniforme: cada gene vem de um dos pais com
+	 * probabilidade 0.5.
+	 */
+	struct UniformCrossover {
+
+		void operator() (const unsigned char * p1, const unsigned char * p2, unsigned char * child,
+						 int rows, int dim, Random & random) const {
+
+			size_t n = (size_t) rows * dim;
+			std::vector<uint64_t> bits ((n + 63) / 64);
+			random.fill (&bits[0], bits.size ());
+
+			for (size_t i=0; i < n; i++) {
+				unsigned char mask = (unsigned char) -(int) ((bits[i >> 6] >> (i & 63)) & 1);
+				child[i] = (unsigned char) ((p1[i] & mask) | (p2[i] & ~mask));
+			}
+		}
+	};
+
+	/**
+	 * Cruzamento de n pontos: os segmentos entre os pontos de corte
+	 * alternam entre os pais.
+	 */
+	struct NPointCrossover {
+
+		NPointCrossover (int points = 2) : m_points (points) {}
+
+		void operator() (const unsigned char * p1, const unsigned char * p2, unsigned char * child,
+						 int rows, int dim, Random & random) const {
+
+			std::vector<int> cuts (m_points + 1);
+
+			for (int r=0; r < rows; r++) {
+				const unsigned char * a = p1 + (size_t) r * dim;
+				const unsigned char * b = p2 + (size_t) r * dim;
+				unsigned char * c = child + (size_t) r * dim;
+
+				for (int k=0; k < m_points; k++) cuts[k] = random.nextInt (dim + 1);
+				cuts[m_points] = dim;
+				std::sort (cuts.begin (), cuts.begin () + m_points);
+
+				int begin = 0;
+				for (int k=0; k <= m_points; k++) {
+					const unsigned char * source = (k % 2 == 0) ? a : b;
+					memcpy (c + begin, source + begin, cuts[k] - begin);
+					begin = cuts[k];
+				}
+			}
+		}
+
+		int m_points;
+	};
+
+	/**
+	 * Mutação bit a bit: cada gene é invertido com probabilidade rate.
+	 */
+	struct BitFlipMutation {
+
+		BitFlipMutation (double rate = 0.01) : m_rate (rate) {}
+
+		void operator() (unsigned char * genes, int rows, int dim, Random & random) const {
+
+			size_t n = (size_t) rows * dim;
+			std::vector<double> u (n);
+			random.fill (&u[0], n);
+
+			for (size_t i=0; i < n; i++) {
+				genes[i] ^= (unsigned char) (u[i] < m_rate);
+			}
+		}
+
+		double m_rate;
+	};
+
+	/*--------------------------------------------------------------------
+	 * Operadores para permutações de 0..dim-1
+	 *------------------------------------------------------------------*/
+
+	/**
+	 * Order crossover (OX1, Davis 1985): o filho recebe um segmento do
+	 * primeiro pai e os demais elementos na ordem em que aparecem no
+	 * segundo pai, a partir do fim do segmento.
+	 */
+	struct OrderCrossover {
+
+		void operator() (const int * p1, const int * p2, int * child,
+						 int rows, int dim, Random & random) const {
+
+			std::vector<char> used (dim);
+
+			for (int r=0; r < rows; r++) {
+				const int * a = p1 + (size_t) r * dim;
+				const int * b = p2 + (size_t) r * dim;
+				int * c = child + (size_t) r * dim;
+
+				int begin = random.nextInt (dim);
+				int end = random.nextInt (dim);
+				if (begin > end) std::swap (begin, end);
+
+				std::fill (used.begin (), used.end (), 0);
+				for (int j=begin; j <= end; j++) {
+					c[j] = a[j];
+					used[a[j]] = 1;
+				}
+
+				int pos = (end + 1) % dim;
+				for (int k=0; k < dim; k++) {
+					int gene = b[(end + 1 + k) % dim];
+					if (used[gene]) continue;
+					c[pos] = gene;
+					pos = (pos + 1) % dim;
+				}
+			}
+		}
+	};
+
+	/**
+	 * Partially mapped crossover (PMX, Goldberg e Lingle 1985).
+	 */
+	struct PMX {
+
+		void operator() (const int * p1, const int * p2, int * child,
+						 int rows, int dim, Random & random) const {
+
+			//posição de cada elemento no primeiro pai
+			std::vector<int> position (dim);
+
+			for (int r=0; r < rows; r++) {
+				const int * a = p1 + (size_t) r * dim;
+				const int * b = p2 + (size_t) r * dim;
+				int * c = child + (size_t) r * dim;
+
+				int begin = random.nextInt (dim);
+				int end = random.nextInt (dim);
+				if (begin > end) std::swap (begin, end);
+
+				for (int j=0; j < dim; j++) position[a[j]] = j;
+
+				memcpy (c, b, dim * sizeof (int));
+				for (int j=begin; j <= end; j++) c[j] = a[j];
+
+				for (int j=0; j < dim; j++) {
+					if (j >= begin && j <= end) continue;
+					int gene = b[j];
+					//segue o mapeamento enquanto o gene pertencer ao segmento
+					while (position[gene] >= begin && position[gene] <= end) {
+						gene = b[position[gene]];
+					}
+					c[j] = gene;
+				}
+			}
+		}
+	};
+
+	/**
+	 * Mutação por troca de duas posições.
+	 */
+	struct SwapMutation {
+
+		void operator() (int * genes, int rows, int dim, Random & random) const {
+			for (int r=0; r < rows; r++) {
+				int * c = genes + (size_t) r * dim;
+				std::swap (c[random.nextInt (dim)], c[random.nextInt (dim)]);
+			}
+		}
+	};
+
+	/*--------------------------------------------------------------------
+	 * Pipeline
+	 *------------------------------------------------------------------*/
+
+	/**
+	 * Pipeline de variação para genótipos std::vector<Gene> de tamanho
+	 * fixo dim. Os estágios não definidos são ignorados (sem cruzamento
+	 * o filho é uma cópia do primeiro pai).
+	 *
+	 * As probabilidades p_cross e p_mut recebidas pelo apply são por
+	 * indivíduo; a probabilidade por gene é parâmetro do operador.
+	 */
+	template <class Gene>
+	class Pipeline {
+
+	public:
+		typedef std::function<void (const Gene *, const Gene *, Gene *, int, int, Random &)> Crossover;
+		typedef std::function<void (Gene *, int, int, Random &)> Mutation;
+		typedef std::function<void (Gene *, int, int)> Repair;
+
+		Pipeline (int dim, ThreadPool * pool = NULL) : m_dim (dim), m_pool (pool) {}
+
+		void setCrossover (const Crossover & crossover) { m_crossover = crossover; }
+		void setMutation (const Mutation & mutation) { m_mutation = mutation; }
+		void setRepair (const Repair & repair) { m_repair = repair; }
+
+		/**
+		 * Os blocos de cada estágio são distribuídos entre as threads de
+		 * pool. Com NULL (padrão) os blocos executam na thread chamadora.
+		 */
+		void setThreadPool (ThreadPool * pool) { m_pool = pool; }
+
+		int dimension () const { return m_dim; }
+
+		/**
+		 * Gera children[i] a partir de p1[i] e p2[i], i em [0, size).
+		 * Os genótipos dos filhos são redimensionados para dim genes.
+		 */
+		template <class Individual>
+		void apply (Individual ** p1, Individual ** p2, Individual ** children,
+					int size, double p_cross, double p_mut, Random & random) {
+
+			const size_t dim = m_dim;
+			const size_t bytes = dim * sizeof (Gene);
+
+			//sorteia quais filhos passam por cada estágio
+			m_crossed.clear ();
+			m_mutated.clear ();
+			for (int i=0; i < size; i++) {
+				if (m_crossover && random.nextDouble () < p_cross) m_crossed.push_back (i);
+				if (m_mutation && random.nextDouble () < p_mut) m_mutated.push_back (i);
+			}
+
+			m_children.resize (size * dim);
+			for (int i=0; i < size; i++) {
+				memcpy (&m_children[i * dim], p1[i]->genotype.data (), bytes);
+			}
+
+			//cruzamento sobre as linhas sorteadas, copiadas de forma contígua
+			int rows = (int) m_crossed.size ();
+			if (rows > 0) {
+				m_first.resize (rows * dim);
+				m_second.resize (rows * dim);
+				m_buffer.resize (rows * dim);
+				for (int k=0; k < rows; k++) {
+					memcpy (&m_first[k * dim], p1[m_crossed[k]]->genotype.data (), bytes);
+					memcpy (&m_second[k * dim], p2[m_crossed[k]]->genotype.data (), bytes);
+				}
+
+				blocks (rows, random, [this, dim] (int begin, int end, Random & rng) {
+					m_crossover (&m_first[begin * dim], &m_second[begin * dim],
+								 &m_buffer[begin * dim], end - begin, (int) dim, rng);
+				});
+
+				for (int k=0; k < rows; k++) {
+					memcpy (&m_children[m_crossed[k] * dim], &m_buffer[k * dim], bytes);
+				}
+			}
+
+			//mutação
+			rows = (int) m_mutated.size ();
+			if (rows > 0) {
+				m_buffer.resize (rows * dim);
+				for (int k=0; k < rows; k++) {
+					memcpy (&m_buffer[k * dim], &m_children[m_mutated[k] * dim], bytes);
+				}
+
+				blocks (rows, random, [this, dim] (int begin, int end, Random & rng) {
+					m_mutation (&m_buffer[begin * dim], end - begin, (int) dim, rng);
+				});
+
+				for (int k=0; k < rows; k++) {
+					memcpy (&m_children[m_mutated[k] * dim], &m_buffer[k * dim], bytes);
+				}
+			}
+
+			//reparo de toda a prole
+			if (m_repair) {
+				blocks (size, random, [this, dim] (int begin, int end, Random &) {
+					m_repair (&m_children[begin * dim], end - begin, (int) dim);
+				});
+			}
+
+			for (int i=0; i < size; i++) {
+				children[i]->genotype.resize (dim);
+				memcpy (children[i]->genotype.data (), &m_children[i * dim], bytes);
+			}
+		}
+
+	private:
+
+		/**
+		 * Executa body (begin, end, rng) para cada bloco de BLOCK linhas
+		 * em [0, rows). Os geradores são semeados antes da execução, na
+		 * ordem dos blocos.
+		 */
+		template <class Body>
+		void blocks (int rows, Random & random, const Body & body) {
+
+			int count = (rows + BLOCK - 1) / BLOCK;
+			m_random.resize (count);
+			for (int b=0; b < count; b++) m_random[b].setSeed (random.next ());
+
+			if (m_pool == NULL || count == 1) {
+				for (int b=0; b < count; b++) {
+					body (b * BLOCK, std::min (rows, (b + 1) * BLOCK), m_random[b]);
+				}
+				return;
+			}
+
+			m_pool->parallelFor (0, count, [this, rows, &body] (int b) {
+				body (b * BLOCK, std::min (rows, (b + 1) * BLOCK), m_random[b]);
+			});
+		}
+
+		int m_dim;
+		ThreadPool * m_pool;
+
+		Crossover m_crossover;
+		Mutation m_mutation;
+		Repair m_repair;
+
+		std::vector<int> m_crossed;
+		std::vector<int> m_mutated;
+		std::vector<Gene> m_first;
+		std::vector<Gene> m_second;
+		std::vector<Gene> m_buffer;
+		std::vector<Gene> m_children;
+		std::vector<Random> m_random;
+	};
+
+	/**
+	 * Verifica se a política de problema fornece recombine para
+	 * indivíduos do tipo Individual.
+	 */
+	template <class Problem, class Individual, class = void>
+	struct has_recombine : std::false_type {};
+
+	template <class Problem, class Individual>
+	struct has_recombine<Problem, Individual, std::void_t<decltype (std::declval<Problem &> ().recombine (
+			std::declval<Individual **> (), std::declval<Individual **> (), std::declval<Individual **> (),
+			0, 0.0, 0.0, std::declval<Random &> ()))> >
+		: std::true_type {};
+
+	/**
+	 * Gera children[i] a partir de p1[i] e p2[i], i em [0, size), pela
+	 * política de problema. Utiliza Problem::recombine quando disponível;
+	 * caso contrário gera cada filho com Problem::crossover e
+	 * Problem::mutation.
+	 */
+	template <class Problem, class Individual>
+	void recombine (Problem & problem, Individual ** p1, Individual ** p2, Individual ** children,
+					int size, double p_cross, double p_mut, Random & random)
+	{
+		if constexpr (has_recombine<Problem, Individual>::value) {
+
+			problem.recombine (p1, p2, children, size, p_cross, p_mut, random);
+
+		} else {
+
+			for (int i=0; i < size; i++) {
+
+				int prob = random.nextInt (10) + 1;
+
+				if ( ((double)prob/10) <= p_cross ) {
+					problem.crossover (p1[i]->genotype, p2[i]->genotype, children[i]->genotype, random);
+				} else {
+					children[i]->genotype = p1[i]->genotype;
+				}
+
+				prob = random.nextInt (10) + 1;
+
+				if ( ((double)prob/10) <= p_mut ) {
+					problem.mutation (children[i]->genotype, random);
+				}
+			}
+		}
+	}
+
+	template <class Problem, class = void>
+	struct has_neighbour : std::false_type {};
+
+	template <class Problem>
+	struct has_neighbour<Problem, std::void_t<decltype (std::declval<Problem &> ().neighbour (
+			std::declval<const typename Problem::genotype_type &> (),
+			std::declval<typename Problem::genotype_type &> (), std::declval<Random &> ()))> >
+		: std::true_type {};
+
+	/**
+	 * Gera em target um vizinho de source, utilizado pela busca local
+	 * (LocalSearchStage). Utiliza Problem::neighbour quando disponível;
+	 * caso contrário target é uma cópia de source com Problem::mutation.
+	 */
+	template <class Problem>
+	void neighbour (Problem & problem, const typename Problem::genotype_type & source,
+					typename Problem::genotype_type & target, Random & random)
+	{
+		if constexpr (has_neighbour<Problem>::value) {
+			problem.neighbour (source, target, random);
+		} else {
+			target = source;
+			problem.mutation (target, random);
+		}
+	}
+
+}
+
+#endif